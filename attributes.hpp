@@ -0,0 +1,59 @@
+#ifndef ATTRIBUTES_H_
+#define ATTRIBUTES_H_
+
+// Loop attributes of the *_attr kernels, set at compile time, e.g.
+// make KERNEL_SRC=kernel_8loads_attr.cxx OPTION="-DLOOP_IVDEP=1 -DLOOP_II=1 -DLOOP_INDEX=uint32_t" fpga
+// Every attribute is left out when its macro is not defined. make attributes sweeps their combinations.
+
+#include <stdint.h>
+
+// Unroll factor of the inner loop
+#ifndef UNROLL
+    #define UNROLL 1
+#endif
+
+// Induction variable type, size_t or uint32_t. main rejects an N that does not fit in it. The kernels
+// count rows rather than elements, so indices never go past N
+#ifndef LOOP_INDEX
+    #define LOOP_INDEX size_t
+#endif
+
+// Elements per row of the nested loops built when LOOP_COALESCE is set, which loop_coalesce may fuse
+// into a single loop. The kernels run a flat loop without it, as kernel_8loads.cxx does
+#ifndef LOOP_ROW
+    #define LOOP_ROW 1024
+#endif
+
+// Outer loop
+#ifdef LOOP_MAX_CONCURRENCY
+    #define ATTR_MAX_CONCURRENCY [[intel::max_concurrency(LOOP_MAX_CONCURRENCY)]]
+#else
+    #define ATTR_MAX_CONCURRENCY
+#endif
+
+#ifdef LOOP_COALESCE
+    #define ATTR_LOOP_COALESCE [[intel::loop_coalesce(LOOP_COALESCE)]]
+#else
+    #define ATTR_LOOP_COALESCE
+#endif
+
+// Inner loop
+#if LOOP_IVDEP
+    #define ATTR_IVDEP [[intel::ivdep]]
+#else
+    #define ATTR_IVDEP
+#endif
+
+#ifdef LOOP_II
+    #define ATTR_II [[intel::initiation_interval(LOOP_II)]]
+#else
+    #define ATTR_II
+#endif
+
+#ifdef LOOP_SPECULATED_ITERATIONS
+    #define ATTR_SPECULATED_ITERATIONS [[intel::speculated_iterations(LOOP_SPECULATED_ITERATIONS)]]
+#else
+    #define ATTR_SPECULATED_ITERATIONS
+#endif
+
+#endif // ATTRIBUTES_H_
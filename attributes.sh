@@ -0,0 +1,68 @@
+#!/bin/bash
+# Builds and runs a *_attr kernel for every combination of loop attributes, then prints the kernel
+# bandwidth of each one, best first. Called by make attributes, e.g.
+#   make attributes ATTR_SRC=kernel_8stores_attr.cxx ATTR_BUILD=fpga ATTR_N=10000000
+# Every variant is a full build, a hardware compile on fpga. By default only loop_coalesce is toggled,
+# so the matrix is two builds; each attribute list is widened from the environment, "-" leaves the
+# attribute out:
+#   ATTR_II="- 1" ATTR_INDEX="size_t uint32_t" make attributes
+# Logs of every variant are kept in attributes/<kernel>/<variant>.log
+
+set -u
+
+src=${1:-kernel_8loads_attr.cxx}
+build=${2:-cpu}
+n=${3:-10000000}
+name=${src%.cxx}
+
+ivdep_list=${ATTR_IVDEP:-"-"}
+concurrency_list=${ATTR_MAX_CONCURRENCY:-"-"}
+speculated_list=${ATTR_SPECULATED_ITERATIONS:-"-"}
+coalesce_list=${ATTR_COALESCE:-"- 2"}
+ii_list=${ATTR_II:-"-"}
+index_list=${ATTR_INDEX:-"size_t"}
+unroll_list=${ATTR_UNROLL:-"1"}
+
+logs=attributes/$name
+mkdir -p "$logs"
+results=$logs/results.txt
+: > "$results"
+
+for ivdep in $ivdep_list; do
+for concurrency in $concurrency_list; do
+for speculated in $speculated_list; do
+for coalesce in $coalesce_list; do
+for ii in $ii_list; do
+for index in $index_list; do
+for unroll in $unroll_list; do
+    option="-DLOOP_INDEX=$index -DUNROLL=$unroll"
+    [ "$ivdep" != "-" ] && option="$option -DLOOP_IVDEP=$ivdep"
+    [ "$concurrency" != "-" ] && option="$option -DLOOP_MAX_CONCURRENCY=$concurrency"
+    [ "$speculated" != "-" ] && option="$option -DLOOP_SPECULATED_ITERATIONS=$speculated"
+    [ "$coalesce" != "-" ] && option="$option -DLOOP_COALESCE=$coalesce"
+    [ "$ii" != "-" ] && option="$option -DLOOP_II=$ii"
+    variant="ivdep${ivdep}_mc${concurrency}_spec${speculated}_coal${coalesce}_ii${ii}_${index}_u${unroll}"
+    log=$logs/$variant.log
+
+    # The kernel object does not depend on OPTION in make's eyes
+    rm -f "$name.o" "$name.so"
+    if ! make KERNEL_SRC="$src" OPTION="$option" "$build" > "$log" 2>&1; then
+        printf "%-56s %12s %12s %12s\n" "$variant" "build" "failed" "-" >> "$results"
+        continue
+    fi
+    ./"$name.$build" "$n" >> "$log" 2>&1
+    # Kernel bandwidth: X GB/s read (n streams), Y GB/s written (m streams)
+    awk -v variant="$variant" '/^Kernel bandwidth:/ {
+        printf "%-56s %12.2f %12.2f %12.2f\n", variant, $3, $8, $3 + $8; found = 1
+    } END { if (!found) printf "%-56s %12s %12s %12s\n", variant, "run", "failed", "-" }' "$log" >> "$results"
+done
+done
+done
+done
+done
+done
+done
+
+echo "Loop attributes of $src on $build, N = $n"
+printf "%-56s %12s %12s %12s\n" "variant" "read GB/s" "write GB/s" "total GB/s"
+sort -k4 -g -r "$results"
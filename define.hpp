@@ -11,10 +11,24 @@ using T = double;
 
 #include <stddef.h>
 
+// Tiled kernels: elements of each stream staged on chip per tile, and banks of each tile memory.
+// Override them at compile time, e.g. make OPTION="-DTILE_SIZE=8192 -DNUM_BANKS=4"
+#ifndef TILE_SIZE
+    #define TILE_SIZE 4096
+#endif
+#ifndef NUM_BANKS
+    #define NUM_BANKS 8
+#endif
+
 typedef struct kernel_timer_t {
     double cpu_to_fpga1, cpu_to_fpga2, fpga_compute, fpga_to_cpu;
 } kernel_timer_s;
 
+typedef struct verify_result_t {
+    double checksum;
+    size_t errors;
+} verify_result_s;
+
 template <typename T> struct buffers4streams {
     T d1, d2, d3, d4;
 };
@@ -3,19 +3,49 @@
 
 #include "define.hpp"
 
-void launcher_loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue);
-void launcher_stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue);
+sycl::event launcher_loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue);
 
 double launcher_loads_profiling(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue);
 double launcher_stores_profiling(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue);
 
-void launcher_4loads(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, sycl::queue queue);
-void launcher_4stores(T *d_input, T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue);
+sycl::event launcher_4loads(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores(T *d_input, T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue);
 
-void launcher_4loads_struct(buffers4streams <T> *b4, T *d_res, size_t N, sycl::queue queue);
-void launcher_4stores_struct(T *d_input, buffers4streams <T> *b4, size_t N, sycl::queue queue);
+sycl::event launcher_4loads_struct(buffers4streams <T> *b4, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores_struct(T *d_input, buffers4streams <T> *b4, size_t N, sycl::queue queue);
 
-void launcher_5loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d_res, size_t N, sycl::queue queue);
-void launcher_5stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, size_t N, sycl::queue queue);
+sycl::event launcher_5loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_5stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, size_t N, sycl::queue queue);
+
+sycl::event launcher_loads_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, size_t N, sycl::queue queue);
+
+sycl::event launcher_4loads_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, size_t N, sycl::queue queue);
+
+sycl::event launcher_4loads_struct_buffer(sycl::buffer<buffers4streams<T>> &b4_buf, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores_struct_buffer(sycl::buffer<T> &b_input, sycl::buffer<buffers4streams<T>> &b4_buf, size_t N, sycl::queue queue);
+
+sycl::event launcher_5loads_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_5stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, size_t N, sycl::queue queue);
+
+sycl::event launcher_loads_only(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_stores_only(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue);
+sycl::event launcher_4loads_only(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores_only(T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue);
+
+sycl::event launcher_loads_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_stores_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, size_t N, sycl::queue queue);
+sycl::event launcher_4loads_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b_res, size_t N, sycl::queue queue);
+sycl::event launcher_4stores_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, size_t N, sycl::queue queue);
+
+sycl::event launcher_loads_tiled(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, size_t R, sycl::queue queue);
+sycl::event launcher_loads_untiled(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, size_t R, sycl::queue queue);
+sycl::event launcher_4loads_tiled(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, size_t R, sycl::queue queue);
+sycl::event launcher_4loads_untiled(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, size_t R, sycl::queue queue);
+
+sycl::event launcher_verify(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t nstreams, T slope,
+                            T offset, T tolerance, verify_result_t *d_result, size_t N, sycl::queue queue);
 
 #endif // KERNEL_H_
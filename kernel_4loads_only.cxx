@@ -0,0 +1,74 @@
+#include "define.hpp"
+#include "kernel.hpp"
+
+static constexpr size_t SUM_LATENCY = 8;
+
+//
+sycl::event launcher_4loads_only(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            // Shift register of partial sums, so that the adder latency does not limit the loop II
+            [[intel::fpga_register]] T partial[SUM_LATENCY + 1] = {};
+
+            for (size_t i = 0; i < N; ++i) {
+                T x1 = d1[i];
+                T x2 = d2[i];
+                T x3 = d3[i];
+                T x4 = d4[i];
+                partial[SUM_LATENCY] = partial[0] + (x1 + x2 + x3 + x4);
+#pragma unroll
+                for (size_t j = 0; j < SUM_LATENCY; ++j)
+                    partial[j] = partial[j + 1];
+            }
+
+            T sum = 0;
+#pragma unroll
+            for (size_t j = 0; j < SUM_LATENCY; ++j)
+                sum += partial[j];
+            d_res[0] = sum;
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_4loads_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b_res, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d1(b1, h, sycl::read_only);
+        sycl::accessor d2(b2, h, sycl::read_only);
+        sycl::accessor d3(b3, h, sycl::read_only);
+        sycl::accessor d4(b4, h, sycl::read_only);
+        sycl::accessor d_res(b_res, h, sycl::write_only, sycl::no_init);
+
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            // Shift register of partial sums, so that the adder latency does not limit the loop II
+            [[intel::fpga_register]] T partial[SUM_LATENCY + 1] = {};
+
+            for (size_t i = 0; i < N; ++i) {
+                T x1 = d1[i];
+                T x2 = d2[i];
+                T x3 = d3[i];
+                T x4 = d4[i];
+                partial[SUM_LATENCY] = partial[0] + (x1 + x2 + x3 + x4);
+#pragma unroll
+                for (size_t j = 0; j < SUM_LATENCY; ++j)
+                    partial[j] = partial[j + 1];
+            }
+
+            T sum = 0;
+#pragma unroll
+            for (size_t j = 0; j < SUM_LATENCY; ++j)
+                sum += partial[j];
+            d_res[0] = sum;
+
+            // End of kernel
+        });
+    });
+}
@@ -2,9 +2,33 @@
 #include "kernel.hpp"
 
 //
-void launcher_4loads_struct(buffers4streams<T>* b4, T *d_res, size_t N, sycl::queue queue)
+sycl::event launcher_4loads_struct(buffers4streams<T>* b4, T *d_res, size_t N, sycl::queue queue)
 {
-    queue.submit([&](sycl::handler &h) {
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+            // Start of kernel
+            [[intel::fpga_register]] T x1, x2, x3, x4;
+
+            for (size_t i = 0; i < N; ++i) {
+                x1 = b4[i].d1;
+                x2 = b4[i].d2;
+                x3 = b4[i].d3;
+                x4 = b4[i].d4;
+                d_res[i] = x1 + x2 + x3 + x4;
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_4loads_struct_buffer(sycl::buffer<buffers4streams<T>> &b4_buf, sycl::buffer<T> &b_res, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor b4(b4_buf, h, sycl::read_only);
+        sycl::accessor d_res(b_res, h, sycl::write_only, sycl::no_init);
+
         h.single_task([=]() [[intel::kernel_args_restrict]] {
             // Start of kernel
             [[intel::fpga_register]] T x1, x2, x3, x4;
@@ -0,0 +1,79 @@
+#include "define.hpp"
+#include "kernel.hpp"
+
+//
+sycl::event launcher_4loads_tiled(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, size_t R, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            for (size_t base = 0; base < N; base += TILE_SIZE) {
+                size_t const len = N - base < TILE_SIZE ? N - base : TILE_SIZE;
+
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T t1[TILE_SIZE];
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T t2[TILE_SIZE];
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T t3[TILE_SIZE];
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T t4[TILE_SIZE];
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T acc[TILE_SIZE];
+
+                // Stage the tile of every stream from DRAM
+#pragma unroll NUM_BANKS
+                for (size_t j = 0; j < len; ++j) {
+                    t1[j] = d1[base + j];
+                    t2[j] = d2[base + j];
+                    t3[j] = d3[base + j];
+                    t4[j] = d4[base + j];
+                    acc[j] = 0;
+                }
+
+                // R passes over the tile, every read is on chip
+                for (size_t r = 0; r < R; ++r) {
+#pragma unroll NUM_BANKS
+                    [[intel::ivdep]]
+                    for (size_t j = 0; j < len; ++j)
+                        acc[j] += t1[j] + t2[j] + t3[j] + t4[j];
+                }
+
+#pragma unroll NUM_BANKS
+                for (size_t j = 0; j < len; ++j)
+                    d_res[base + j] = acc[j];
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+// Same passes as launcher_4loads_tiled, reading every pass from DRAM instead of the staged tiles
+sycl::event launcher_4loads_untiled(T *d1, T *d2, T *d3, T *d4, T *d_res, size_t N, size_t R, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            for (size_t base = 0; base < N; base += TILE_SIZE) {
+                size_t const len = N - base < TILE_SIZE ? N - base : TILE_SIZE;
+
+                [[intel::fpga_memory("BLOCK_RAM"), intel::numbanks(NUM_BANKS), intel::bankwidth(sizeof(T))]] T acc[TILE_SIZE];
+
+#pragma unroll NUM_BANKS
+                for (size_t j = 0; j < len; ++j)
+                    acc[j] = 0;
+
+                for (size_t r = 0; r < R; ++r) {
+#pragma unroll NUM_BANKS
+                    [[intel::ivdep]]
+                    for (size_t j = 0; j < len; ++j)
+                        acc[j] += d1[base + j] + d2[base + j] + d3[base + j] + d4[base + j];
+                }
+
+#pragma unroll NUM_BANKS
+                for (size_t j = 0; j < len; ++j)
+                    d_res[base + j] = acc[j];
+            }
+
+            // End of kernel
+        });
+    });
+}
@@ -2,9 +2,41 @@
 #include "kernel.hpp"
 
 //
-void launcher_4stores(T *d_input, T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue)
+sycl::event launcher_4stores(T *d_input, T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue)
 {
-    queue.submit([&](sycl::handler &h) {
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+#pragma unroll 32
+            for (size_t i = 0; i < N; ++i) {
+                T input = d_input[i];
+                T x1 = input + 1;
+                T x2 = input + 2;
+                T x3 = input + 3;
+                T x4 = input + 4;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_4stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d_input(b_input, h, sycl::read_only);
+        sycl::accessor d1(b1, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d2(b2, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d3(b3, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d4(b4, h, sycl::write_only, sycl::no_init);
+
         h.single_task([=]() [[intel::kernel_args_restrict]] {
         // Start of kernel
 
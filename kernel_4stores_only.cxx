@@ -0,0 +1,59 @@
+#include "define.hpp"
+#include "kernel.hpp"
+
+//
+sycl::event launcher_4stores_only(T *d1, T *d2, T *d3, T *d4, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            for (size_t i = 0; i < N; ++i) {
+                // Generated from the index, no input stream
+                T x = T(i);
+                T x1 = x + 1;
+                T x2 = x + 2;
+                T x3 = x + 3;
+                T x4 = x + 4;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_4stores_only_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d1(b1, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d2(b2, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d3(b3, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d4(b4, h, sycl::write_only, sycl::no_init);
+
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            for (size_t i = 0; i < N; ++i) {
+                // Generated from the index, no input stream
+                T x = T(i);
+                T x1 = x + 1;
+                T x2 = x + 2;
+                T x3 = x + 3;
+                T x4 = x + 4;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+            }
+
+            // End of kernel
+        });
+    });
+}
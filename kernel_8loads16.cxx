@@ -2,9 +2,44 @@
 #include "kernel.hpp"
 
 //
-void launcher_loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue)
+sycl::event launcher_loads(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, T *d_res, size_t N, sycl::queue queue)
 {
-    queue.submit([&](sycl::handler &h) {
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+#pragma unroll 16
+            for (size_t i = 0; i < N; ++i) {
+                T x1 = d1[i];
+                T x2 = d2[i];
+                T x3 = d3[i];
+                T x4 = d4[i];
+                T x5 = d5[i];
+                T x6 = d6[i];
+                T x7 = d7[i];
+                T x8 = d8[i];
+                d_res[i] = x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8;
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_loads_buffer(sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, sycl::buffer<T> &b_res, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d1(b1, h, sycl::read_only);
+        sycl::accessor d2(b2, h, sycl::read_only);
+        sycl::accessor d3(b3, h, sycl::read_only);
+        sycl::accessor d4(b4, h, sycl::read_only);
+        sycl::accessor d5(b5, h, sycl::read_only);
+        sycl::accessor d6(b6, h, sycl::read_only);
+        sycl::accessor d7(b7, h, sycl::read_only);
+        sycl::accessor d8(b8, h, sycl::read_only);
+        sycl::accessor d_res(b_res, h, sycl::write_only, sycl::no_init);
+
         h.single_task([=]() [[intel::kernel_args_restrict]] {
         // Start of kernel
 
@@ -2,9 +2,52 @@
 #include "kernel.hpp"
 
 //
-void launcher_stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue)
+sycl::event launcher_stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue)
 {
-    queue.submit([&](sycl::handler &h) {
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            for (size_t i = 0; i < N; ++i) {
+                T input = d_input[i];
+                T x1 = input + 1;
+                T x2 = input + 2;
+                T x3 = input + 3;
+                T x4 = input + 4;
+                T x5 = input + 5;
+                T x6 = input + 6;
+                T x7 = input + 7;
+                T x8 = input + 8;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+                d5[i] = x5;
+                d6[i] = x6;
+                d7[i] = x7;
+                d8[i] = x8;
+            }
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d_input(b_input, h, sycl::read_only);
+        sycl::accessor d1(b1, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d2(b2, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d3(b3, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d4(b4, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d5(b5, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d6(b6, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d7(b7, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d8(b8, h, sycl::write_only, sycl::no_init);
+
         h.single_task([=]() [[intel::kernel_args_restrict]] {
         // Start of kernel
 
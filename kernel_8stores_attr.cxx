@@ -0,0 +1,129 @@
+#include "attributes.hpp"
+#include "define.hpp"
+#include "kernel.hpp"
+
+//
+sycl::event launcher_stores(T *d_input, T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            LOOP_INDEX const n = LOOP_INDEX(N);
+            // One element of the stream loop, shared by the loop shapes below
+            auto const element = [&](LOOP_INDEX const i) {
+                T input = d_input[i];
+                T x1 = input + 1;
+                T x2 = input + 2;
+                T x3 = input + 3;
+                T x4 = input + 4;
+                T x5 = input + 5;
+                T x6 = input + 6;
+                T x7 = input + 7;
+                T x8 = input + 8;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+                d5[i] = x5;
+                d6[i] = x6;
+                d7[i] = x7;
+                d8[i] = x8;
+            };
+
+#ifdef LOOP_COALESCE
+            // Rows of a fixed trip count, so that loop_coalesce can fuse the nest into a single loop
+            LOOP_INDEX const rows = n / LOOP_ROW;
+            ATTR_MAX_CONCURRENCY ATTR_LOOP_COALESCE
+            for (LOOP_INDEX row = 0; row < rows; ++row) {
+#pragma unroll UNROLL
+                ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+                for (LOOP_INDEX j = 0; j < LOOP_ROW; ++j)
+                    element(row * LOOP_ROW + j);
+            }
+            // Last partial row
+#pragma unroll UNROLL
+            ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+            for (LOOP_INDEX i = rows * LOOP_ROW; i < n; ++i)
+                element(i);
+#else
+            // Flat loop, as in kernel_8stores.cxx
+#pragma unroll UNROLL
+            ATTR_MAX_CONCURRENCY ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+            for (LOOP_INDEX i = 0; i < n; ++i)
+                element(i);
+#endif
+
+            // End of kernel
+        });
+    });
+}
+
+//
+sycl::event launcher_stores_buffer(sycl::buffer<T> &b_input, sycl::buffer<T> &b1, sycl::buffer<T> &b2, sycl::buffer<T> &b3, sycl::buffer<T> &b4, sycl::buffer<T> &b5, sycl::buffer<T> &b6, sycl::buffer<T> &b7, sycl::buffer<T> &b8, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        sycl::accessor d_input(b_input, h, sycl::read_only);
+        sycl::accessor d1(b1, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d2(b2, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d3(b3, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d4(b4, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d5(b5, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d6(b6, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d7(b7, h, sycl::write_only, sycl::no_init);
+        sycl::accessor d8(b8, h, sycl::write_only, sycl::no_init);
+
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+        // Start of kernel
+
+            LOOP_INDEX const n = LOOP_INDEX(N);
+            // One element of the stream loop, shared by the loop shapes below
+            auto const element = [&](LOOP_INDEX const i) {
+                T input = d_input[i];
+                T x1 = input + 1;
+                T x2 = input + 2;
+                T x3 = input + 3;
+                T x4 = input + 4;
+                T x5 = input + 5;
+                T x6 = input + 6;
+                T x7 = input + 7;
+                T x8 = input + 8;
+
+                d1[i] = x1;
+                d2[i] = x2;
+                d3[i] = x3;
+                d4[i] = x4;
+                d5[i] = x5;
+                d6[i] = x6;
+                d7[i] = x7;
+                d8[i] = x8;
+            };
+
+#ifdef LOOP_COALESCE
+            // Rows of a fixed trip count, so that loop_coalesce can fuse the nest into a single loop
+            LOOP_INDEX const rows = n / LOOP_ROW;
+            ATTR_MAX_CONCURRENCY ATTR_LOOP_COALESCE
+            for (LOOP_INDEX row = 0; row < rows; ++row) {
+#pragma unroll UNROLL
+                ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+                for (LOOP_INDEX j = 0; j < LOOP_ROW; ++j)
+                    element(row * LOOP_ROW + j);
+            }
+            // Last partial row
+#pragma unroll UNROLL
+            ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+            for (LOOP_INDEX i = rows * LOOP_ROW; i < n; ++i)
+                element(i);
+#else
+            // Flat loop, as in kernel_8stores.cxx
+#pragma unroll UNROLL
+            ATTR_MAX_CONCURRENCY ATTR_IVDEP ATTR_II ATTR_SPECULATED_ITERATIONS
+            for (LOOP_INDEX i = 0; i < n; ++i)
+                element(i);
+#endif
+
+            // End of kernel
+        });
+    });
+}
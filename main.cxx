@@ -1,21 +1,29 @@
 #include "define.hpp"
 #include "kernel.hpp"
+#include "results.hpp"
+#include "trace.hpp"
 
 #include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath> // for std::abs
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <getopt.h>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <stddef.h>
 #include <string>
 #include <string_view>
 #include <sycl/sycl.hpp>
 #include <sys/time.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #if FPGA_HARDWARE || FPGA_EMULATOR || FPGA_SIMULATOR
     #include <sycl/ext/intel/fpga_extensions.hpp>
@@ -34,9 +42,19 @@ using std::chrono::high_resolution_clock;
 
 // Defaults
 static constexpr size_t NB_ITER = 100;
+// Iterations per reuse factor, the untiled kernel reads its streams R times
+static constexpr size_t NB_REUSE_ITER = 10;
 
 constexpr T tolerance = static_cast<T>(1e-6);
 
+// Set by the Makefile, recorded with every run
+#ifndef GIT_REVISION
+    #define GIT_REVISION "unknown"
+#endif
+#ifndef KERNEL_OPTION
+    #define KERNEL_OPTION ""
+#endif
+
 /*** Print device information
  * @param q the oneAPI queue
  */
@@ -87,6 +105,741 @@ static void timers_print(std::array<double, NB_ITER> const &timers, std::string_
     printf("\n");
 }
 
+/*** Host and device pointers of every stream a mode may touch. */
+struct streams_t {
+    T *h_input, *d_input, *h_res, *d_res;
+    std::array<T *, 8> h, d;
+};
+
+/*** Number of streams read and written by the kernel of a mode, e.g. 8 + 1 for
+ * "8loads", 1 + 8 for "8stores", 8 + 0 for "8loads_only" and 0 + 8 for
+ * "8stores_only".
+ * @param MODE the mode name
+ */
+static std::pair<size_t, size_t> mode_streams(std::string_view const MODE)
+{
+    size_t const n = size_t(MODE[0] - '0');
+    bool const only = MODE.find("_only") != MODE.npos;
+    if (MODE.substr(1, 5) == "loads") return { n, only ? 0 : 1 };
+    return { only ? 0 : 1, n };
+}
+
+struct mode_bytes_t {
+    size_t cpu_to_fpga, fpga_compute, fpga_to_cpu;
+};
+
+/*** Bytes copied in, moved by the kernel and copied back per iteration of a
+ * mode. Loads-only modes copy back a single scalar.
+ * @param MODE the mode name
+ * @param N count of elements
+ */
+static mode_bytes_t mode_bytes(std::string_view const MODE, size_t const N)
+{
+    auto const [loads, stores] = mode_streams(MODE);
+    size_t const alloc_size = sizeof(T) * N;
+    if (MODE.substr(1, 5) == "loads" && stores == 0)
+        return { loads * alloc_size, loads * alloc_size, sizeof(T) };
+    return { loads * alloc_size, (loads + stores) * alloc_size, stores * alloc_size };
+}
+
+/*** Allocates a host stream, aligned on alignment bytes if non zero.
+ * @param bytes size of the stream, in bytes
+ * @param alignment alignment, in bytes, a power of two
+ */
+static T *host_alloc(size_t const bytes, size_t const alignment)
+{
+    if (alignment == 0) return reinterpret_cast<T *>(malloc(bytes));
+    size_t const rounded = (bytes + alignment - 1) / alignment * alignment;
+    return reinterpret_cast<T *>(std::aligned_alloc(alignment, rounded));
+}
+
+/*** Allocates a device stream, aligned on alignment bytes if non zero.
+ * @param bytes size of the stream, in bytes
+ * @param alignment alignment, in bytes, a power of two
+ * @param queue the oneAPI queue
+ */
+static T *device_alloc(size_t const bytes, size_t const alignment, queue &queue)
+{
+    size_t const count = (bytes + sizeof(T) - 1) / sizeof(T);
+    if (alignment == 0) return sycl::malloc_device<T>(count, queue);
+    return sycl::aligned_alloc_device<T>(alignment, count, queue);
+}
+
+/*** Returns the largest power of two dividing an address, up to 2 MB.
+ * @param p the address
+ */
+static size_t address_alignment(void const *const p)
+{
+    size_t const a = reinterpret_cast<uintptr_t>(p);
+    size_t alignment = 1;
+    while (alignment < (size_t(2) << 20) && a % (alignment * 2) == 0)
+        alignment *= 2;
+    return alignment;
+}
+
+/*** Returns the duration of a profiled event, in ns.
+ * @param e the event
+ */
+static double event_t_ns(sycl::event const &e)
+{
+    return static_cast<double>(e.get_profiling_info<info::event_profiling::command_end>()) -
+           static_cast<double>(e.get_profiling_info<info::event_profiling::command_start>());
+}
+
+/*** Returns the time between the first start and the last end of a set of
+ * profiled events, in ns.
+ * @param events the events
+ */
+static double events_span_ns(std::vector<sycl::event> const &events)
+{
+    if (events.empty()) return 0.0;
+    uint64_t start = UINT64_MAX, end = 0;
+    for (auto const &e : events) {
+        start = min(start, e.get_profiling_info<info::event_profiling::command_start>());
+        end = std::max(end, e.get_profiling_info<info::event_profiling::command_end>());
+    }
+    return static_cast<double>(end - start);
+}
+
+/*** Enqueues the input streams copies of a mode, without waiting.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param alloc_size size of a stream, in bytes
+ * @param queue the oneAPI queue
+ */
+static std::vector<sycl::event> enqueue_cpu_to_fpga(std::string_view const MODE, streams_t const &s,
+                                                    size_t const alloc_size, queue &queue)
+{
+    std::vector<sycl::event> events;
+    if (MODE.substr(1, 5) == "loads") {
+        size_t const n = mode_streams(MODE).first;
+        for (size_t k = 0; k < n; ++k)
+            events.push_back(queue.memcpy(s.d[k], s.h[k], alloc_size));
+    }
+    if (MODE.substr(1, 6) == "stores" && mode_streams(MODE).first == 1) {
+        events.push_back(queue.memcpy(s.d_input, s.h_input, alloc_size));
+    }
+    return events;
+}
+
+/*** Enqueues the kernel of a mode, without waiting. Profiling modes are not
+ * handled here as their launchers wait for the kernel.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param b4 the struct buffer, for struct modes
+ * @param N count of elements
+ * @param queue the oneAPI queue
+ */
+static sycl::event enqueue_kernel(std::string_view const MODE, streams_t const &s, buffers4streams<T> *b4,
+                                  size_t const N, queue &queue)
+{
+    auto const &d = s.d;
+    // ONLY
+    if (MODE.substr(0, 11) == "8loads_only") {
+        return launcher_loads_only(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 12) == "8stores_only") {
+        return launcher_stores_only(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], N, queue);
+    }
+    else if (MODE.substr(0, 11) == "4loads_only") {
+        return launcher_4loads_only(d[0], d[1], d[2], d[3], s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 12) == "4stores_only") {
+        return launcher_4stores_only(d[0], d[1], d[2], d[3], N, queue);
+    }
+    // TILED, a single pass over each tile
+    else if (MODE.substr(0, 12) == "8loads_tiled") {
+        return launcher_loads_tiled(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], s.d_res, N, 1, queue);
+    }
+    else if (MODE.substr(0, 12) == "4loads_tiled") {
+        return launcher_4loads_tiled(d[0], d[1], d[2], d[3], s.d_res, N, 1, queue);
+    }
+    // 8
+    else if (MODE.substr(0, 6) == "8loads") {
+        return launcher_loads(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 7) == "8stores") {
+        return launcher_stores(s.d_input, d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], N, queue);
+    }
+    // 4 & STRUCT
+    else if (MODE.substr(0, 13) == "4loads_struct") {
+        return launcher_4loads_struct(b4, s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 14) == "4stores_struct") {
+        return launcher_4stores_struct(s.d_input, b4, N, queue);
+    }
+    // 4
+    else if (MODE.substr(0, 6) == "4loads") {
+        return launcher_4loads(d[0], d[1], d[2], d[3], s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 7) == "4stores") {
+        return launcher_4stores(s.d_input, d[0], d[1], d[2], d[3], N, queue);
+    }
+    // 5
+    else if (MODE.substr(0, 6) == "5loads") {
+        return launcher_5loads(d[0], d[1], d[2], d[3], d[4], s.d_res, N, queue);
+    }
+    else if (MODE.substr(0, 7) == "5stores") {
+        return launcher_5stores(s.d_input, d[0], d[1], d[2], d[3], d[4], N, queue);
+    }
+    return sycl::event{};
+}
+
+/*** Enqueues the output streams copies of a mode, without waiting.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param alloc_size size of a stream, in bytes
+ * @param queue the oneAPI queue
+ */
+static std::vector<sycl::event> enqueue_fpga_to_cpu(std::string_view const MODE, streams_t const &s,
+                                                    size_t const alloc_size, queue &queue)
+{
+    std::vector<sycl::event> events;
+    if (MODE.substr(1, 5) == "loads") {
+        // Loads-only kernels reduce their streams to d_res[0]
+        size_t const res_size = mode_streams(MODE).second == 0 ? sizeof(T) : alloc_size;
+        events.push_back(queue.memcpy(s.h_res, s.d_res, res_size));
+    }
+    if (MODE.substr(1, 6) == "stores") {
+        size_t const n = mode_streams(MODE).second;
+        for (size_t k = 0; k < n; ++k)
+            events.push_back(queue.memcpy(s.h[k], s.d[k], alloc_size));
+    }
+    return events;
+}
+
+/*** Prints a throughput given the bytes moved per iteration and the total
+ * time spent over all iterations.
+ * @param name throughput's name
+ * @param bytes bytes moved per iteration
+ * @param time_us total time over NB_ITER iterations, in us
+ */
+static void throughput_print(std::string_view const name, size_t const bytes, double const time_us)
+{
+    printf("%-24s%8.2f GB/s  (%.1f MB in %.3f ms)\n", name.data(),
+           double(bytes) * double(NB_ITER) / time_us / 1e3, double(bytes) * double(NB_ITER) / 1e6,
+           time_us / 1e3);
+}
+
+/*** Expected result of a loads-only kernel, the sum of i + k over every element
+ * i of every stream k.
+ * @param loads count of streams
+ * @param N count of elements
+ */
+static T loads_only_expected(size_t const loads, size_t const N)
+{
+    return T(loads) * T(N) * T(N - 1) / 2 + T(N) * T(loads * (loads + 1) / 2);
+}
+
+/*** Verifies every element of the output streams of a mode on the device, and
+ * copies back a single verify_result_t. Returns whether the verification passed.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param N count of elements
+ * @param queue the oneAPI queue
+ * @param trace the timeline
+ */
+static bool device_verify_print(std::string_view const MODE, streams_t const &s, size_t const N, queue &queue,
+                                trace_t &trace)
+{
+    auto const [loads, stores] = mode_streams(MODE);
+    bool const is_loads = MODE.substr(1, 5) == "loads";
+    auto d = s.d;
+    if (is_loads) d[0] = s.d_res;
+
+    // loads: d_res[i] = n * i + (1 + ... + n), stores: d_k[i] = i + k
+    size_t nstreams = is_loads ? 1 : stores, count = N;
+    T slope = is_loads ? T(loads) : T(1);
+    T offset = is_loads ? T(loads * (loads + 1) / 2) : T(1);
+    // loads-only: the single d_res[0] = sum of the loads streams
+    if (is_loads && stores == 0) {
+        count = 1;
+        slope = T(0);
+        offset = loads_only_expected(loads, N);
+    }
+
+    verify_result_t *d_result = sycl::malloc_device<verify_result_t>(1, queue);
+    verify_result_t h_result;
+
+    auto const t1 = high_resolution_clock::now();
+    sycl::event const verify_event = launcher_verify(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], nstreams,
+                                                     slope, offset, tolerance, d_result, count, queue);
+    trace_submit(trace, "verify kernel", verify_event, t1, NB_ITER);
+    auto const copy_t1 = trace_clock::now();
+    // USM commands are not ordered on an out-of-order queue, the copy waits for the kernel
+    sycl::event copy_event = queue.memcpy(&h_result, d_result, sizeof(verify_result_t), verify_event);
+    trace_submit(trace, "copy verify result", copy_event, copy_t1, NB_ITER);
+    auto const wait_t1 = trace_clock::now();
+    copy_event.wait();
+    trace_wait(trace, "verify", wait_t1, NB_ITER);
+    auto const t2 = high_resolution_clock::now();
+    std::chrono::duration<double, std::micro> const t_verify = t2 - t1;
+    sycl::free(d_result, queue);
+
+    double const n = double(count);
+    double const expected_checksum =
+        double(nstreams) * (double(slope) * n * (n - 1) / 2 + double(offset) * n) +
+        n * double(nstreams * (nstreams - 1) / 2);
+    bool const ok = h_result.errors == 0 &&
+                    std::abs(h_result.checksum - expected_checksum) <= 1e-12 * std::abs(expected_checksum);
+
+    cout << "Device verification: " << h_result.errors << " errors over " << nstreams * count
+         << " elements, checksum " << setprecision(17) << h_result.checksum << " == " << expected_checksum
+         << setprecision(6) << (ok ? " OK\n" : " FAIL\n");
+    printf("                     %.1f us kernel, %.1f us including %zu B copy back\n",
+           event_t_ns(verify_event) / 1e3, t_verify.count(), sizeof(verify_result_t));
+    return ok;
+}
+
+/*** Runs the kernel of a mode once through sycl::buffer: the runtime copies the
+ * inputs in, and the outputs back when the buffers go out of scope.
+ * Returns the kernel event, complete once the outputs are back.
+ * @param MODE the mode name
+ * @param s the streams, only host pointers are used
+ * @param b4 the struct host array, for struct modes
+ * @param N count of elements
+ * @param queue the oneAPI queue
+ */
+static sycl::event buffer_iteration(std::string_view const MODE, streams_t const &s, buffers4streams<T> *b4,
+                                    size_t const N, queue &queue)
+{
+    bool const is_loads = MODE.substr(1, 5) == "loads";
+    sycl::range<1> const r(N);
+    sycl::event e;
+    {
+        // Buffers built on const host pointers are never written back
+        sycl::buffer<T> b_input(static_cast<T const *>(s.h_input), r);
+        // loads-only modes reduce to d_res[0], only that element is copied back
+        sycl::range<1> const r_res(MODE.find("loads_only") != MODE.npos ? 1 : N);
+        sycl::buffer<T> b_res = is_loads ? sycl::buffer<T>(s.h_res, r_res)
+                                         : sycl::buffer<T>(static_cast<T const *>(s.h_res), r_res);
+        std::vector<sycl::buffer<T>> b;
+        for (size_t k = 0; k < 8; ++k)
+            b.push_back(is_loads ? sycl::buffer<T>(static_cast<T const *>(s.h[k]), r)
+                                 : sycl::buffer<T>(s.h[k], r));
+        sycl::buffer<buffers4streams<T>> b4_buf =
+            is_loads ? sycl::buffer<buffers4streams<T>>(static_cast<buffers4streams<T> const *>(b4), r)
+                     : sycl::buffer<buffers4streams<T>>(b4, r);
+
+        // ONLY
+        if (MODE.substr(0, 11) == "8loads_only") {
+            e = launcher_loads_only_buffer(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b_res, N, queue);
+        }
+        else if (MODE.substr(0, 12) == "8stores_only") {
+            e = launcher_stores_only_buffer(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], N, queue);
+        }
+        else if (MODE.substr(0, 11) == "4loads_only") {
+            e = launcher_4loads_only_buffer(b[0], b[1], b[2], b[3], b_res, N, queue);
+        }
+        else if (MODE.substr(0, 12) == "4stores_only") {
+            e = launcher_4stores_only_buffer(b[0], b[1], b[2], b[3], N, queue);
+        }
+        // 8
+        else if (MODE.substr(0, 6) == "8loads") {
+            e = launcher_loads_buffer(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], b_res, N, queue);
+        }
+        else if (MODE.substr(0, 7) == "8stores") {
+            e = launcher_stores_buffer(b_input, b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], N, queue);
+        }
+        // 4 & STRUCT
+        else if (MODE.substr(0, 13) == "4loads_struct") {
+            e = launcher_4loads_struct_buffer(b4_buf, b_res, N, queue);
+        }
+        else if (MODE.substr(0, 14) == "4stores_struct") {
+            e = launcher_4stores_struct_buffer(b_input, b4_buf, N, queue);
+        }
+        // 4
+        else if (MODE.substr(0, 6) == "4loads") {
+            e = launcher_4loads_buffer(b[0], b[1], b[2], b[3], b_res, N, queue);
+        }
+        else if (MODE.substr(0, 7) == "4stores") {
+            e = launcher_4stores_buffer(b_input, b[0], b[1], b[2], b[3], N, queue);
+        }
+        // 5
+        else if (MODE.substr(0, 6) == "5loads") {
+            e = launcher_5loads_buffer(b[0], b[1], b[2], b[3], b[4], b_res, N, queue);
+        }
+        else if (MODE.substr(0, 7) == "5stores") {
+            e = launcher_5stores_buffer(b_input, b[0], b[1], b[2], b[3], b[4], N, queue);
+        }
+    }
+    return e;
+}
+
+/*** Prints USM and buffer timers side by side. The time outside the kernel is
+ * the copies for USM, and for buffers the whole buffer overhead: construction,
+ * accessors, copies and the write-back on destruction.
+ * @param usm_total USM iteration timers
+ * @param usm_compute USM kernel timers
+ * @param buffer_total buffer iteration timers
+ * @param buffer_compute buffer kernel timers
+ * @param bytes bytes moved between the host and the device per iteration
+ */
+static void usm_buffer_print(std::array<double, NB_ITER> const &usm_total,
+                             std::array<double, NB_ITER> const &usm_compute,
+                             std::array<double, NB_ITER> const &buffer_total,
+                             std::array<double, NB_ITER> const &buffer_compute, size_t const bytes)
+{
+    results_t const ut = timers_stats(usm_total), uc = timers_stats(usm_compute);
+    results_t const bt = timers_stats(buffer_total), bc = timers_stats(buffer_compute);
+
+    cout << "-----------------------------------------------------------\n-- USM vs buffer --\n";
+    printf("                          USM                      buffer\n");
+    printf("Iteration (mean ± σ)    %9.1f us ± %7.1f µs   %9.1f us ± %7.1f µs\n", ut.mean,
+           ut.standard_deviation, bt.mean, bt.standard_deviation);
+    printf("          (min … max)   %9.1f us … %7.1f µs   %9.1f us … %7.1f µs\n", ut.min, ut.max, bt.min,
+           bt.max);
+    printf("Kernel    (mean ± σ)    %9.1f us ± %7.1f µs   %9.1f us ± %7.1f µs\n", uc.mean,
+           uc.standard_deviation, bc.mean, bc.standard_deviation);
+    printf("Outside kernel (mean)   %9.1f us               %9.1f us\n", ut.mean - uc.mean, bt.mean - bc.mean);
+    printf("  as bandwidth          %9.2f GB/s             %9.2f GB/s\n",
+           double(bytes) / (ut.mean - uc.mean) / 1e3, double(bytes) / (bt.mean - bc.mean) / 1e3);
+    printf("                          copies                   buffer overhead (construction + copies)\n");
+    printf("\n");
+}
+
+/*** Runs NB_ITER iterations split across T host threads, each one submitting
+ * the copies and kernel of its own slice of the streams, for T = 1, 2, 4, ...
+ * below max_threads, then max_threads itself. Prints the total throughput and
+ * the host time spent in each submission call.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param N count of elements
+ * @param max_threads largest thread count
+ * @param shared_queue whether threads share a single queue or own one each
+ * @param kernel_only skip the copies
+ * @param queue the main oneAPI queue, only its context and device are used
+ */
+static void threads_sweep_print(std::string_view const MODE, streams_t const &s, size_t const N,
+                                size_t const max_threads, bool const shared_queue, bool const kernel_only,
+                                queue &queue)
+{
+    auto const per_iteration = mode_bytes(MODE, N);
+    size_t const bytes = kernel_only ? 0 : per_iteration.cpu_to_fpga + per_iteration.fpga_to_cpu;
+
+    cout << "-----------------------------------------------------------\n-- Host submission threads ("
+         << (shared_queue ? "shared queue" : "one queue per thread") << ") --\n";
+    printf("threads   wall (ms)   iteration (us)   transfers (GB/s)   submit mean (us)   submit max (us)\n");
+
+    // Queues share the main queue's context, so that USM allocations stay valid. The main queue is in
+    // order under --back-to-back, the shared queue is out of order like the per-thread ones
+    sycl::queue shared(queue.get_context(), queue.get_device(), sycl::property::queue::enable_profiling{});
+
+    std::vector<size_t> thread_counts;
+    for (size_t nthreads = 1; nthreads < max_threads; nthreads *= 2)
+        thread_counts.push_back(nthreads);
+    thread_counts.push_back(max_threads);
+
+    for (size_t const nthreads : thread_counts) {
+        std::vector<sycl::queue> queues;
+        for (size_t i = 0; i < (shared_queue ? 0 : nthreads); ++i)
+            queues.emplace_back(queue.get_context(), queue.get_device(),
+                                sycl::property::queue::enable_profiling{});
+        std::vector<std::vector<double>> submit_us(nthreads);
+
+        auto const worker = [&](size_t const i) {
+            sycl::queue &q = shared_queue ? shared : queues[i];
+            size_t const lo = N * i / nthreads, n = N * (i + 1) / nthreads - lo;
+            streams_t slice = s;
+            slice.h_input += lo;
+            slice.d_input += lo;
+            slice.h_res += lo;
+            slice.d_res += lo;
+            for (size_t k = 0; k < 8; ++k) {
+                slice.h[k] += lo;
+                slice.d[k] += lo;
+            }
+
+            for (size_t t = 0; t < NB_ITER; ++t) {
+                if (!kernel_only) {
+                    auto const t1 = high_resolution_clock::now();
+                    auto const events = enqueue_cpu_to_fpga(MODE, slice, n * sizeof(T), q);
+                    std::chrono::duration<double, std::micro> const submit =
+                        high_resolution_clock::now() - t1;
+                    submit_us[i].push_back(submit.count() / double(events.size()));
+                    sycl::event::wait(events);
+                }
+                auto const t1 = high_resolution_clock::now();
+                sycl::event e = enqueue_kernel(MODE, slice, nullptr, n, q);
+                std::chrono::duration<double, std::micro> const submit = high_resolution_clock::now() - t1;
+                submit_us[i].push_back(submit.count());
+                e.wait();
+                if (!kernel_only) {
+                    auto const t2 = high_resolution_clock::now();
+                    auto const events = enqueue_fpga_to_cpu(MODE, slice, n * sizeof(T), q);
+                    std::chrono::duration<double, std::micro> const submit_back =
+                        high_resolution_clock::now() - t2;
+                    submit_us[i].push_back(submit_back.count() / double(events.size()));
+                    sycl::event::wait(events);
+                }
+            }
+        };
+
+        auto const t1 = high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nthreads; ++i)
+            threads.emplace_back(worker, i);
+        for (auto &thread : threads)
+            thread.join();
+        auto const t2 = high_resolution_clock::now();
+        std::chrono::duration<double, std::micro> const wall = t2 - t1;
+
+        double submit_sum = 0.0, submit_max = 0.0;
+        size_t submit_count = 0;
+        for (auto const &v : submit_us) {
+            submit_sum = std::accumulate(v.begin(), v.end(), submit_sum);
+            submit_max = std::max(submit_max, *std::max_element(v.begin(), v.end()));
+            submit_count += v.size();
+        }
+
+        printf("%7zu   %9.3f   %14.1f   %16.2f   %16.2f   %15.2f\n", nthreads, wall.count() / 1e3,
+               wall.count() / double(NB_ITER), double(bytes) * double(NB_ITER) / wall.count() / 1e3,
+               submit_sum / double(submit_count), submit_max);
+    }
+    printf("\n");
+}
+
+/*** Runs NB_ITER synchronized iterations with the start of every host and
+ * device stream shifted by each of the given byte offsets. Prints the copies
+ * and kernel bandwidths, from device timestamps, for each offset.
+ * @param MODE the mode name
+ * @param s the streams, allocated with room for the largest offset
+ * @param N count of elements
+ * @param offsets byte offsets, multiples of alignof(T)
+ * @param kernel_only skip the copies
+ * @param queue the oneAPI queue
+ */
+static void offsets_sweep_print(std::string_view const MODE, streams_t const &s, size_t const N,
+                                std::vector<size_t> const &offsets, bool const kernel_only, queue &queue)
+{
+    size_t const alloc_size = N * sizeof(T);
+    auto const [cpu_to_fpga_bytes, fpga_compute_bytes, fpga_to_cpu_bytes] = mode_bytes(MODE, N);
+
+    auto const shift = [](T *p, size_t const offset) {
+        return reinterpret_cast<T *>(reinterpret_cast<char *>(p) + offset);
+    };
+
+    cout << "-----------------------------------------------------------\n-- Stream offsets --\n";
+    printf("offset (B)   host align   device align   CPU to FPGA (GB/s)   compute (GB/s)   "
+           "FPGA to CPU (GB/s)\n");
+    for (size_t const offset : offsets) {
+        streams_t slice = s;
+        slice.h_input = shift(s.h_input, offset);
+        slice.d_input = shift(s.d_input, offset);
+        slice.h_res = shift(s.h_res, offset);
+        slice.d_res = shift(s.d_res, offset);
+        for (size_t k = 0; k < 8; ++k) {
+            slice.h[k] = shift(s.h[k], offset);
+            slice.d[k] = shift(s.d[k], offset);
+        }
+
+        double cpu_to_fpga = 0.0, fpga_compute = 0.0, fpga_to_cpu = 0.0;
+        for (size_t t = 0; t < NB_ITER; ++t) {
+            if (!kernel_only) {
+                auto const events = enqueue_cpu_to_fpga(MODE, slice, alloc_size, queue);
+                sycl::event::wait(events);
+                cpu_to_fpga += events_span_ns(events) / 1e3;
+            }
+            sycl::event e = enqueue_kernel(MODE, slice, nullptr, N, queue);
+            e.wait();
+            fpga_compute += event_t_ns(e) / 1e3;
+            if (!kernel_only) {
+                auto const events = enqueue_fpga_to_cpu(MODE, slice, alloc_size, queue);
+                sycl::event::wait(events);
+                fpga_to_cpu += events_span_ns(events) / 1e3;
+            }
+        }
+
+        auto const bandwidth = [](size_t const bytes, double const time_us) {
+            return time_us > 0.0 ? double(bytes) * double(NB_ITER) / time_us / 1e3 : 0.0;
+        };
+        printf("%10zu   %10zu   %12zu   %18.2f   %14.2f   %18.2f\n", offset, address_alignment(slice.h[0]),
+               address_alignment(slice.d[0]), bandwidth(cpu_to_fpga_bytes, cpu_to_fpga),
+               bandwidth(fpga_compute_bytes, fpga_compute), bandwidth(fpga_to_cpu_bytes, fpga_to_cpu));
+    }
+    printf("\n");
+}
+
+/*** Runs the tiled kernel of a mode and its untiled counterpart, which reads
+ * every pass from DRAM, for each reuse factor R. Prints both kernel times, the
+ * DRAM bandwidth of the tiled kernel and the effective bandwidth of both, i.e.
+ * the R passes over the loads streams per kernel time, and the smallest R for
+ * which staging the tiles on chip pays back.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param N count of elements
+ * @param reuse reuse factors
+ * @param queue the oneAPI queue
+ */
+static void reuse_sweep_print(std::string_view const MODE, streams_t const &s, size_t const N,
+                              std::vector<size_t> reuse, queue &queue)
+{
+    size_t const alloc_size = N * sizeof(T);
+    auto const [loads, stores] = mode_streams(MODE);
+    auto const &d = s.d;
+    bool const is_8 = MODE[0] == '8';
+    std::sort(reuse.begin(), reuse.end());
+
+    // Inputs are constant, copy them once and time kernels only
+    sycl::event::wait(enqueue_cpu_to_fpga(MODE, s, alloc_size, queue));
+
+    verify_result_t *d_result = sycl::malloc_device<verify_result_t>(1, queue);
+    verify_result_t h_result;
+
+    cout << "-----------------------------------------------------------\n-- On-chip reuse --\n";
+    printf("Tile: %d elements per stream, %d banks, %zu iterations per reuse factor\n", TILE_SIZE, NUM_BANKS,
+           NB_REUSE_ITER);
+    printf("     R   untiled (us)   tiled (us)   tiled DRAM (GB/s)   effective untiled (GB/s)   "
+           "effective tiled (GB/s)   speedup   result\n");
+    size_t break_even = 0;
+    for (size_t const R : reuse) {
+        double untiled = 0.0, tiled = 0.0;
+        for (size_t t = 0; t < NB_REUSE_ITER; ++t) {
+            sycl::event e = is_8 ? launcher_loads_untiled(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+                                                          s.d_res, N, R, queue)
+                                 : launcher_4loads_untiled(d[0], d[1], d[2], d[3], s.d_res, N, R, queue);
+            e.wait();
+            untiled += event_t_ns(e) / 1e3;
+            e = is_8 ? launcher_loads_tiled(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], s.d_res, N, R,
+                                            queue)
+                     : launcher_4loads_tiled(d[0], d[1], d[2], d[3], s.d_res, N, R, queue);
+            e.wait();
+            tiled += event_t_ns(e) / 1e3;
+        }
+        untiled /= double(NB_REUSE_ITER);
+        tiled /= double(NB_REUSE_ITER);
+
+        // d_res[i] = R * (n * i + 1 + ... + n)
+        sycl::event const verify_event =
+            launcher_verify(s.d_res, d[1], d[2], d[3], d[4], d[5], d[6], d[7], 1, T(R * loads),
+                            T(R * loads * (loads + 1) / 2), tolerance, d_result, N, queue);
+        queue.memcpy(&h_result, d_result, sizeof(verify_result_t), verify_event).wait();
+
+        auto const bandwidth = [](size_t const bytes, double const time_us) {
+            return time_us > 0.0 ? double(bytes) / time_us / 1e3 : 0.0;
+        };
+        size_t const consumed = R * loads * alloc_size, dram = (loads + stores) * alloc_size;
+        printf("%6zu   %12.1f   %10.1f   %17.2f   %24.2f   %22.2f   %6.2fx   %s\n", R, untiled, tiled,
+               bandwidth(dram, tiled), bandwidth(consumed, untiled), bandwidth(consumed, tiled),
+               tiled > 0.0 ? untiled / tiled : 0.0, h_result.errors == 0 ? "OK" : "FAIL");
+        if (break_even == 0 && tiled < untiled) break_even = R;
+    }
+    sycl::free(d_result, queue);
+
+    if (break_even > 0) printf("Tiling pays back from R = %zu\n\n", break_even);
+    else printf("Tiling does not pay back up to R = %zu\n\n", reuse.back());
+}
+
+/*** Checks a few elements of the output streams copied back to the host.
+ * Returns whether they all match.
+ * @param MODE the mode name
+ * @param s the streams
+ * @param N count of elements
+ * @param h_expected_res expected results storage
+ * @param indices the elements to check
+ */
+static bool host_verify_print(std::string_view const MODE, streams_t const &s, size_t const N,
+                              T *h_expected_res, std::array<size_t, 7> const &indices)
+{
+    // ONLY, loads are reduced to a single element
+    if (MODE.find("loads_only") != MODE.npos) {
+        h_expected_res[0] = loads_only_expected(mode_streams(MODE).first, N);
+        cout << "[sum] res: " << setprecision(17) << s.h_res[0] << " == " << h_expected_res[0]
+             << setprecision(6);
+        bool const ok = std::abs(s.h_res[0] - h_expected_res[0]) < tolerance;
+        cout << (ok ? " OK\n" : " FAIL\n");
+        return ok;
+    }
+
+    bool ok = true;
+    for (auto const &j : indices) {
+        T tmp = 0;
+        // 8
+        if (MODE.substr(0, 6) == "8loads") {
+            h_expected_res[j] = 8 * s.h_input[j] + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8;
+            tmp = s.h_res[j];
+        }
+        else if (MODE.substr(0, 7) == "8stores") {
+            h_expected_res[j] = 8 * s.h_input[j] + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8;
+            tmp = s.h[0][j] + s.h[1][j] + s.h[2][j] + s.h[3][j] + s.h[4][j] + s.h[5][j] + s.h[6][j] +
+                  s.h[7][j];
+        }
+        // 4
+        else if (MODE.substr(0, 6) == "4loads") {
+            h_expected_res[j] = 4 * s.h_input[j] + 1 + 2 + 3 + 4;
+            tmp = s.h_res[j];
+        }
+        else if (MODE.substr(0, 7) == "4stores") {
+            h_expected_res[j] = 4 * s.h_input[j] + 1 + 2 + 3 + 4;
+            tmp = s.h[0][j] + s.h[1][j] + s.h[2][j] + s.h[3][j];
+        }
+        // 5
+        else if (MODE.substr(0, 6) == "5loads") {
+            h_expected_res[j] = 5 * s.h_input[j] + 1 + 2 + 3 + 4 + 5;
+            tmp = s.h_res[j];
+        }
+        else if (MODE.substr(0, 7) == "5stores") {
+            h_expected_res[j] = 5 * s.h_input[j] + 1 + 2 + 3 + 4 + 5;
+            tmp = s.h[0][j] + s.h[1][j] + s.h[2][j] + s.h[3][j] + s.h[4][j];
+        }
+
+        cout << "[" << j << "] res: " << tmp << " == " << h_expected_res[j];
+        if (std::abs(tmp - h_expected_res[j]) < tolerance) cout << " OK\n";
+        else {
+            cout << " FAIL\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/*** Unroll factor of a mode, from the trailing digits of its name, e.g. 16 for
+ * "8loads16", or the UNROLL the kernels were compiled with.
+ * @param MODE the mode name
+ */
+static size_t mode_unroll(std::string_view const MODE)
+{
+    size_t const digits = MODE.find_last_not_of("0123456789") + 1;
+    if (digits < MODE.size()) return size_t(atol(std::string(MODE.substr(digits)).c_str()));
+#ifdef UNROLL
+    return UNROLL;
+#else
+    return 1;
+#endif
+}
+
+/*** Parses a comma-separated list of sizes, e.g. "0,8,64".
+ * @param list the list
+ */
+static std::vector<size_t> list_parse(std::string_view list)
+{
+    std::vector<size_t> values;
+    while (!list.empty()) {
+        size_t const comma = min(list.find(','), list.size());
+        values.push_back(size_t(atol(std::string(list.substr(0, comma)).c_str())));
+        list.remove_prefix(min(comma + 1, list.size()));
+    }
+    return values;
+}
+
+static void usage(std::string_view const exec)
+{
+    cerr << "Usage: " << exec << " [options] [N]\n"
+         << "  N                   count of elements per stream (default 1e7)\n"
+         << "  -b, --back-to-back  enqueue all iterations back to back and synchronize once\n"
+         << "  -v, --device-verify verify every output element on the device\n"
+         << "  -k, --kernel-only   copy inputs once, time kernels only and skip copies back (implies -v)\n"
+         << "  -B, --buffer        also run the sycl::buffer implementation and compare it with USM\n"
+         << "  -t, --trace FILE    write a Chrome trace-event timeline of every copy, kernel and wait\n"
+         << "  -T, --threads T     also submit from 1, 2, 4, ... T host threads, each one owning a slice\n"
+         << "  -S, --shared-queue  threads submit to one shared queue instead of owning one each\n"
+         << "  -a, --align BYTES   align host and device streams on BYTES, e.g. 64, 4096 or 2097152\n"
+         << "  -O, --offsets LIST  also run with every stream shifted by each comma-separated byte offset\n"
+         << "  -R, --reuse LIST    tiled modes: reuse factors to sweep (default 1,2,4,8,16,32)\n"
+         << "  -r, --results FILE  append the results to FILE (default results.jsonl, \"\" to disable)\n"
+         << "  -h, --help          print this help\n";
+}
+
 int main(int argc, char *argv[])
 {
     std::string_view const exec(argv[0]);
@@ -101,7 +854,108 @@ int main(int argc, char *argv[])
 
     auto const MODE = exec.substr(start_pos, end_pos - start_pos);
     size_t N = 1e7;
-    if (argc > 1) N = size_t(atoi(argv[1]));
+    bool back_to_back = false;
+    bool device_verify = false;
+    bool kernel_only = false;
+    bool use_buffers = false;
+    std::string trace_path;
+    size_t max_threads = 0;
+    bool shared_queue = false;
+    size_t alignment = 0;
+    std::vector<size_t> offsets;
+    std::vector<size_t> reuse;
+    std::string results_path = "results.jsonl";
+
+    static struct option const long_options[] = {
+        { "back-to-back", no_argument, nullptr, 'b' },
+        { "device-verify", no_argument, nullptr, 'v' },
+        { "kernel-only", no_argument, nullptr, 'k' },
+        { "buffer", no_argument, nullptr, 'B' },
+        { "trace", required_argument, nullptr, 't' },
+        { "threads", required_argument, nullptr, 'T' },
+        { "shared-queue", no_argument, nullptr, 'S' },
+        { "align", required_argument, nullptr, 'a' },
+        { "offsets", required_argument, nullptr, 'O' },
+        { "reuse", required_argument, nullptr, 'R' },
+        { "results", required_argument, nullptr, 'r' },
+        { "help", no_argument, nullptr, 'h' },
+        { nullptr, 0, nullptr, 0 },
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "bvkBt:T:Sa:O:R:r:h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'b': back_to_back = true; break;
+            case 'v': device_verify = true; break;
+            case 'k': kernel_only = device_verify = true; break;
+            case 'B': use_buffers = true; break;
+            case 't': trace_path = optarg; break;
+            case 'T': {
+                int const threads = atoi(optarg);
+                if (threads <= 0) {
+                    cerr << "Thread count " << optarg << " is not positive\n";
+                    return 1;
+                }
+                max_threads = size_t(threads);
+                break;
+            }
+            case 'S': shared_queue = true; break;
+            case 'a': alignment = size_t(atol(optarg)); break;
+            case 'O': offsets = list_parse(optarg); break;
+            case 'R': reuse = list_parse(optarg); break;
+            case 'r': results_path = optarg; break;
+            case 'h': usage(exec); return 0;
+            default: usage(exec); return 1;
+        }
+    }
+    if (optind < argc) N = size_t(atoi(argv[optind]));
+
+    if ((back_to_back || max_threads > 0) &&
+        (MODE.find("_profiling") != MODE.npos || MODE.find("_struct") != MODE.npos)) {
+        cerr << "Mode " << MODE
+             << " waits on the host between iterations, back-to-back and threads are not supported\n";
+        return 1;
+    }
+#ifdef LOOP_INDEX
+    // The *_attr kernels count elements with LOOP_INDEX, main is built with the same OPTION
+    if (N > std::numeric_limits<LOOP_INDEX>::max()) {
+        cerr << "N = " << N << " does not fit in the LOOP_INDEX the kernel was compiled with\n";
+        return 1;
+    }
+#endif
+    if (alignment & (alignment - 1)) {
+        cerr << "Alignment " << alignment << " is not a power of two\n";
+        return 1;
+    }
+    for (size_t const offset : offsets) {
+        if (offset % alignof(T) != 0) {
+            cerr << "Offset " << offset << " is not a multiple of the " << alignof(T)
+                 << " B element alignment\n";
+            return 1;
+        }
+    }
+    if (!offsets.empty() && (MODE.find("_profiling") != MODE.npos || MODE.find("_struct") != MODE.npos)) {
+        cerr << "Mode " << MODE << " does not take its streams as pointers, offsets are not supported\n";
+        return 1;
+    }
+    if (use_buffers && kernel_only) {
+        cerr << "The buffer implementation always transfers its streams, it cannot be compared kernel-only\n";
+        return 1;
+    }
+    bool const tiled = MODE.find("_tiled") != MODE.npos;
+    if (!reuse.empty() && !tiled) {
+        cerr << "Mode " << MODE << " does not stage its streams on chip, reuse factors are not supported\n";
+        return 1;
+    }
+    if (tiled && reuse.empty()) reuse = { 1, 2, 4, 8, 16, 32 };
+    if (use_buffers && tiled) {
+        cerr << "Mode " << MODE << " has no buffer implementation\n";
+        return 1;
+    }
+    if (device_verify && MODE.find("_struct") != MODE.npos) {
+        cerr << "Mode " << MODE
+             << " does not write its output to device streams, it cannot be verified on device\n";
+        return 1;
+    }
 
 #if FPGA_EMULATOR
     // Intel extension: FPGA emulator selector on systems without FPGA card.
@@ -120,7 +974,12 @@ int main(int argc, char *argv[])
     cerr << "Creating device queue - loading FPGA design\n";
     // Create the device queue
     auto t1 = high_resolution_clock::now();
-    sycl::queue queue(selector, sycl::property::queue::enable_profiling{});
+    // Back-to-back iterations rely on the queue order instead of host waits
+    sycl::property_list const queue_properties =
+        back_to_back ? sycl::property_list{ sycl::property::queue::enable_profiling{},
+                                            sycl::property::queue::in_order{} }
+                     : sycl::property_list{ sycl::property::queue::enable_profiling{} };
+    sycl::queue queue(selector, queue_properties);
     auto t2 = high_resolution_clock::now();
     std::chrono::duration<double, std::milli> t_queue = t2 - t1;
     cerr << "FPGA design loaded in " << std::setprecision(2) << t_queue.count() / 1e3 << "s \n";
@@ -128,41 +987,45 @@ int main(int argc, char *argv[])
     auto device = queue.get_device();
     if (!queue.get_device().has(sycl::aspect::queue_profiling)) {
         cerr << "Device does not support profiling." << std::endl;
+        if (back_to_back || !trace_path.empty()) return 1;
         // return 1;
     }
     PrintTargetInfo(queue);
 
     // Allocations
     size_t alloc_size = sizeof(T) * N;
-    T *h_input = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d_input = sycl::malloc_device<T>(alloc_size, queue);
+    // Room for the largest stream offset
+    size_t const max_offset = offsets.empty() ? 0 : *std::max_element(offsets.begin(), offsets.end());
+    size_t const alloc_bytes = alloc_size + max_offset;
+    T *h_input = host_alloc(alloc_bytes, alignment);
+    T *d_input = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h_res = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d_res = sycl::malloc_device<T>(alloc_size, queue);
+    T *h_res = host_alloc(alloc_bytes, alignment);
+    T *d_res = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h1 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d1 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h1 = host_alloc(alloc_bytes, alignment);
+    T *d1 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h2 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d2 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h2 = host_alloc(alloc_bytes, alignment);
+    T *d2 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h3 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d3 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h3 = host_alloc(alloc_bytes, alignment);
+    T *d3 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h4 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d4 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h4 = host_alloc(alloc_bytes, alignment);
+    T *d4 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h5 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d5 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h5 = host_alloc(alloc_bytes, alignment);
+    T *d5 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h6 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d6 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h6 = host_alloc(alloc_bytes, alignment);
+    T *d6 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h7 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d7 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h7 = host_alloc(alloc_bytes, alignment);
+    T *d7 = device_alloc(alloc_bytes, alignment, queue);
 
-    T *h8 = reinterpret_cast<T *>(malloc(alloc_size));
-    T *d8 = sycl::malloc_device<T>(alloc_size, queue);
+    T *h8 = host_alloc(alloc_bytes, alignment);
+    T *d8 = device_alloc(alloc_bytes, alignment, queue);
 
     // if ((!strncmp(MODE, "4loads_struct", 13)) || (!strncmp(MODE, "4stores_struct", 14)))
     buffers4streams<T> *b4 = new buffers4streams<T>[N];
@@ -182,16 +1045,106 @@ int main(int argc, char *argv[])
         h8[i] = T(i) + T(8);
         h_res[i] = T(0);
     }
+    // Shifted streams read up to max_offset bytes past the initialized elements
+    for (T *h : { h_input, h_res, h1, h2, h3, h4, h5, h6, h7, h8 })
+        memset(reinterpret_cast<char *>(h) + alloc_size, 0, max_offset);
+
+    streams_t const streams{ h_input, d_input, h_res, d_res, { h1, h2, h3, h4, h5, h6, h7, h8 },
+                             { d1, d2, d3, d4, d5, d6, d7, d8 } };
 
     // timers allocations
     std::array<double, NB_ITER> timers_cpu_to_fpga;
     std::array<double, NB_ITER> timers_fpga_compute;
     std::array<double, NB_ITER> timers_fpga_to_cpu;
 
+    // Inputs are constant over the iterations, kernel-only runs copy them once
+    if (kernel_only) {
+        enqueue_cpu_to_fpga(MODE, streams, alloc_size, queue);
+        queue.wait();
+    }
+
+    trace_t trace;
+    trace.enabled = !trace_path.empty();
+
     // Kernel
     auto t1_simu = high_resolution_clock::now();
+    trace.origin = t1_simu;
+
+    if (back_to_back) {
+        // Enqueue every iteration, then synchronize once
+        std::array<std::vector<sycl::event>, NB_ITER> cpu_to_fpga_events, fpga_to_cpu_events;
+        std::array<sycl::event, NB_ITER> fpga_compute_events;
+        std::vector<sycl::event> all_events;
+
+        for (size_t t = 0; t < NB_ITER; ++t) {
+            auto submit_t1 = trace_clock::now();
+            if (!kernel_only) {
+                cpu_to_fpga_events[t] = enqueue_cpu_to_fpga(MODE, streams, alloc_size, queue);
+                trace_submit(trace, "copy CPU to FPGA", cpu_to_fpga_events[t], submit_t1, t);
+            }
+            submit_t1 = trace_clock::now();
+            fpga_compute_events[t] = enqueue_kernel(MODE, streams, b4, N, queue);
+            trace_submit(trace, "kernel", fpga_compute_events[t], submit_t1, t);
+            if (!kernel_only) {
+                submit_t1 = trace_clock::now();
+                fpga_to_cpu_events[t] = enqueue_fpga_to_cpu(MODE, streams, alloc_size, queue);
+                trace_submit(trace, "copy FPGA to CPU", fpga_to_cpu_events[t], submit_t1, t);
+            }
+
+            all_events.insert(all_events.end(), cpu_to_fpga_events[t].begin(), cpu_to_fpga_events[t].end());
+            all_events.push_back(fpga_compute_events[t]);
+            all_events.insert(all_events.end(), fpga_to_cpu_events[t].begin(), fpga_to_cpu_events[t].end());
+        }
+        auto const wait_t1 = trace_clock::now();
+        queue.wait();
+        auto const t2_b2b = high_resolution_clock::now();
+        trace_wait(trace, "all iterations", wait_t1, NB_ITER - 1);
+
+        for (size_t t = 0; t < NB_ITER; ++t) {
+            double const cpu_to_fpga = events_span_ns(cpu_to_fpga_events[t]) / 1e3;
+            double const fpga_compute = event_t_ns(fpga_compute_events[t]) / 1e3;
+            double const fpga_to_cpu = events_span_ns(fpga_to_cpu_events[t]) / 1e3;
+
+            printf("  compute time: %.2f ms (%.2f, %.0f us, %.2f)\n",
+                   (cpu_to_fpga + fpga_compute + fpga_to_cpu) / 1e3, cpu_to_fpga / 1e3, fpga_compute,
+                   fpga_to_cpu / 1e3);
+
+            timers_cpu_to_fpga[t] = cpu_to_fpga;
+            timers_fpga_compute[t] = fpga_compute;
+            timers_fpga_to_cpu[t] = fpga_to_cpu;
+        }
+
+        // Device span, from the first command started to the last one completed
+        double const device_span = events_span_ns(all_events) / 1e3;
+        std::chrono::duration<double, std::micro> const host_span = t2_b2b - t1_simu;
+
+        auto const bytes = mode_bytes(MODE, N);
+        size_t const cpu_to_fpga_bytes = kernel_only ? 0 : bytes.cpu_to_fpga;
+        size_t const fpga_to_cpu_bytes = kernel_only ? 0 : bytes.fpga_to_cpu;
+        size_t const fpga_compute_bytes = bytes.fpga_compute;
+
+        cout << "-----------------------------------------------------------\n"
+             << "-- Back-to-back steady state --\n";
+        printf("Host wall time:         %.3f ms (%zu iterations, 1 synchronization)\n",
+               host_span.count() / 1e3, NB_ITER);
+        printf("Device span:            %.3f ms\n", device_span / 1e3);
+        printf("Iteration throughput:   %.1f it/s\n", double(NB_ITER) / host_span.count() * 1e6);
+        if (!kernel_only)
+            throughput_print("Copy CPU to FPGA:", cpu_to_fpga_bytes, timers_stats(timers_cpu_to_fpga).sum);
+        throughput_print("FPGA compute:", fpga_compute_bytes, timers_stats(timers_fpga_compute).sum);
+        if (!kernel_only) {
+            throughput_print("Copy FPGA to CPU:", fpga_to_cpu_bytes, timers_stats(timers_fpga_to_cpu).sum);
+            throughput_print("Transfers (device span):", cpu_to_fpga_bytes + fpga_to_cpu_bytes, device_span);
+            throughput_print("Transfers (host wall):", cpu_to_fpga_bytes + fpga_to_cpu_bytes,
+                             host_span.count());
+        }
+        else {
+            throughput_print("FPGA compute (device span):", fpga_compute_bytes, device_span);
+        }
+        printf("\n");
+    }
 
-    for (size_t t = 0; t < NB_ITER; ++t) {
+    for (size_t t = 0; !back_to_back && t < NB_ITER; ++t) {
         struct timespec cpu_to_fpga_t1, cpu_to_fpga_t2, fpga_compute_t1, fpga_compute_t2, fpga_to_cpu_t1,
             fpga_to_cpu_t2;
 
@@ -200,113 +1153,71 @@ int main(int argc, char *argv[])
         /* copy cpu to fpga */
         clock_gettime(CLOCK_MONOTONIC, &cpu_to_fpga_t1);
 
-        if (MODE.substr(1, 5) == "loads") {
-            queue.memcpy(d1, h1, alloc_size);
-            queue.memcpy(d2, h2, alloc_size);
-            queue.memcpy(d3, h3, alloc_size);
-            queue.memcpy(d4, h4, alloc_size);
-        }
-        if (MODE.substr(0, 6) == "5loads") {
-            queue.memcpy(d5, h5, alloc_size);
-        }
-        if (MODE.substr(0, 6) == "8loads") {
-            queue.memcpy(d5, h5, alloc_size);
-            queue.memcpy(d6, h6, alloc_size);
-            queue.memcpy(d7, h7, alloc_size);
-            queue.memcpy(d8, h8, alloc_size);
-        }
-        if (MODE.substr(1, 6) == "stores") {
-            queue.memcpy(d_input, h_input, alloc_size);
+        auto trace_t1 = trace_clock::now();
+        if (!kernel_only) {
+            auto const events = enqueue_cpu_to_fpga(MODE, streams, alloc_size, queue);
+            trace_submit(trace, "copy CPU to FPGA", events, trace_t1, t);
         }
+        trace_t1 = trace_clock::now();
         queue.wait();
+        trace_wait(trace, "copy CPU to FPGA", trace_t1, t);
 
         clock_gettime(CLOCK_MONOTONIC, &cpu_to_fpga_t2);
 
         /* Computation */
         clock_gettime(CLOCK_MONOTONIC, &fpga_compute_t1);
 
-        // 8 PROFILING
+        // 8 PROFILING, the launchers wait for their kernel
+        trace_t1 = trace_clock::now();
         if (MODE.substr(0, 16) == "8loads_profiling") {
             fpga_compute = launcher_loads_profiling(d1, d2, d3, d4, d5, d6, d7, d8, d_res, N, queue);
+            trace_wait(trace, "kernel (profiling launcher)", trace_t1, t);
         }
         else if (MODE.substr(0, 17) == "8stores_profiling") {
             fpga_compute = launcher_stores_profiling(d_input, d1, d2, d3, d4, d5, d6, d7, d8, N, queue);
+            trace_wait(trace, "kernel (profiling launcher)", trace_t1, t);
         }
-        // 8
-        else if (MODE.substr(0, 6) == "8loads") {
-            launcher_loads(d1, d2, d3, d4, d5, d6, d7, d8, d_res, N, queue);
-        }
-        else if (MODE.substr(0, 7) == "8stores") {
-            launcher_stores(d_input, d1, d2, d3, d4, d5, d6, d7, d8, N, queue);
-        }
-        // 4 & STRUCT
-        else if (MODE.substr(0, 13) == "4loads_struct") {
-            for (size_t i = 0; i < N; ++i) {
-                b4[i].d1 = d1[i];
-                b4[i].d2 = d2[i];
-                b4[i].d3 = d3[i];
-                b4[i].d4 = d4[i];
-            }
-            clock_gettime(CLOCK_MONOTONIC, &fpga_compute_t1);
-            launcher_4loads_struct(b4, d_res, N, queue);
-        }
-        else if (MODE.substr(0, 14) == "4stores_struct") {
-            for (size_t i = 0; i < N; ++i) {
-                b4[i].d1 = d1[i];
-                b4[i].d2 = d2[i];
-                b4[i].d3 = d3[i];
-                b4[i].d4 = d4[i];
+        else {
+            // STRUCT
+            if (MODE.substr(0, 13) == "4loads_struct" || MODE.substr(0, 14) == "4stores_struct") {
+                for (size_t i = 0; i < N; ++i) {
+                    b4[i].d1 = d1[i];
+                    b4[i].d2 = d2[i];
+                    b4[i].d3 = d3[i];
+                    b4[i].d4 = d4[i];
+                }
+                clock_gettime(CLOCK_MONOTONIC, &fpga_compute_t1);
+                trace_host(trace, "host", "pack struct", trace_t1, trace_clock::now(), t);
+                trace_t1 = trace_clock::now();
             }
-            clock_gettime(CLOCK_MONOTONIC, &fpga_compute_t1);
-            launcher_4stores_struct(d_input, b4, N, queue);
-        }
-        // 4
-        else if (MODE.substr(0, 6) == "4loads") {
-            launcher_4loads(d1, d2, d3, d4, d_res, N, queue);
-        }
-        else if (MODE.substr(0, 7) == "4stores") {
-            launcher_4stores(d_input, d1, d2, d3, d4, N, queue);
-        }
-        // 5
-        else if (MODE.substr(0, 6) == "5loads") {
-            launcher_5loads(d1, d2, d3, d4, d5, d_res, N, queue);
-        }
-        else if (MODE.substr(0, 7) == "5stores") {
-            launcher_5stores(d_input, d1, d2, d3, d4, d5, N, queue);
+            trace_submit(trace, "kernel", enqueue_kernel(MODE, streams, b4, N, queue), trace_t1, t);
         }
+        trace_t1 = trace_clock::now();
         queue.wait();
+        trace_wait(trace, "kernel", trace_t1, t);
         clock_gettime(CLOCK_MONOTONIC, &fpga_compute_t2);
 
         if (MODE.substr(0, 14) == "4stores_struct") {
+            trace_t1 = trace_clock::now();
             for (size_t i = 0; i < N; ++i) {
                 d1[i] = b4[i].d1;
                 d2[i] = b4[i].d2;
                 d3[i] = b4[i].d3;
                 d4[i] = b4[i].d4;
             }
+            trace_host(trace, "host", "unpack struct", trace_t1, trace_clock::now(), t);
         }
 
         /* copy fpga to cpu */
         clock_gettime(CLOCK_MONOTONIC, &fpga_to_cpu_t1);
-        if (MODE.substr(1, 5) == "loads") {
-            queue.memcpy(h_res, d_res, alloc_size);
-        }
-        if (MODE.substr(1, 6) == "stores") {
-            queue.memcpy(h1, d1, alloc_size);
-            queue.memcpy(h2, d2, alloc_size);
-            queue.memcpy(h3, d3, alloc_size);
-            queue.memcpy(h4, d4, alloc_size);
-        }
-        if (MODE.substr(0, 7) == "5stores") {
-            queue.memcpy(h5, d5, alloc_size);
-        }
-        if (MODE.substr(0, 7) == "8stores") {
-            queue.memcpy(h5, d5, alloc_size);
-            queue.memcpy(h6, d6, alloc_size);
-            queue.memcpy(h7, d7, alloc_size);
-            queue.memcpy(h8, d8, alloc_size);
+        trace_t1 = trace_clock::now();
+        if (!kernel_only) {
+            auto const events = enqueue_fpga_to_cpu(MODE, streams, alloc_size, queue);
+            trace_submit(trace, "copy FPGA to CPU", events, trace_t1, t);
         }
+        trace_t1 = trace_clock::now();
         queue.wait();
+        trace_wait(trace, "copy FPGA to CPU", trace_t1, t);
         clock_gettime(CLOCK_MONOTONIC, &fpga_to_cpu_t2);
 
         cpu_to_fpga = double(cpu_to_fpga_t2.tv_sec - cpu_to_fpga_t1.tv_sec) * 1e6 +
@@ -336,50 +1247,129 @@ int main(int argc, char *argv[])
     cout << "\nMode:  " << MODE << "\n";
     cout << "Items: " << N << "\n";
 
-    for (auto const &j : indices) {
-        T tmp = 0;
-        // 8
-        if (MODE.substr(0, 6) == "8loads") {
-            h_expected_res[j] = 8 * h_input[j] + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8;
-            tmp = h_res[j];
-        }
-        else if (MODE.substr(0, 7) == "8stores") {
-            h_expected_res[j] = 8 * h_input[j] + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8;
-            tmp = h1[j] + h2[j] + h3[j] + h4[j] + h5[j] + h6[j] + h7[j] + h8[j];
-        }
-        // 4
-        else if (MODE.substr(0, 6) == "4loads") {
-            h_expected_res[j] = 4 * h_input[j] + 1 + 2 + 3 + 4;
-            tmp = h_res[j];
+    // Host data is only up to date when the outputs were copied back
+    bool verify_failed = false;
+    if (!kernel_only) verify_failed = !host_verify_print(MODE, streams, N, h_expected_res, indices);
+
+    auto t2_simu = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_simu = t2_simu - t1_simu;
+
+    if (device_verify) verify_failed |= !device_verify_print(MODE, streams, N, queue, trace);
+
+    if (!kernel_only) timers_print(timers_cpu_to_fpga, "-- copy CPU to FPGA --");
+    timers_print(timers_fpga_compute, "-- FPGA compute time --");
+    if (!kernel_only) timers_print(timers_fpga_to_cpu, "-- copy FPGA to CPU --");
+
+    // Kernel bandwidth per direction, from the mean compute time
+    auto const [loads, stores] = mode_streams(MODE);
+    double const compute_mean = timers_stats(timers_fpga_compute).mean;
+    printf("Kernel bandwidth: %.2f GB/s read (%zu streams), %.2f GB/s written (%zu streams)\n\n",
+           double(loads * alloc_size) / compute_mean / 1e3, loads,
+           double(stores * alloc_size) / compute_mean / 1e3, stores);
+
+    printf("Simulation execution time: %.3lf s\n", t_simu.count() / 1e3);
+    printf("Iteration execution time:  %.3lf ms\n", t_simu.count() / double(NB_ITER - 1));
+
+    if (use_buffers) {
+        std::array<double, NB_ITER> timers_usm_total, timers_buffer_total, timers_buffer_compute;
+        for (size_t t = 0; t < NB_ITER; ++t)
+            timers_usm_total[t] = timers_cpu_to_fpga[t] + timers_fpga_compute[t] + timers_fpga_to_cpu[t];
+
+        // Struct modes read their streams from the struct host array
+        if (MODE.substr(0, 13) == "4loads_struct") {
+            for (size_t i = 0; i < N; ++i) {
+                b4[i].d1 = h1[i];
+                b4[i].d2 = h2[i];
+                b4[i].d3 = h3[i];
+                b4[i].d4 = h4[i];
+            }
         }
-        else if (MODE.substr(0, 7) == "4stores") {
-            h_expected_res[j] = 4 * h_input[j] + 1 + 2 + 3 + 4;
-            tmp = h1[j] + h2[j] + h3[j] + h4[j];
+
+        // Clear the outputs the USM runs left on the host, so that the buffers are what gets verified
+        if (MODE.substr(1, 5) == "loads") memset(h_res, 0, alloc_size);
+        else {
+            for (T *h : { h1, h2, h3, h4, h5, h6, h7, h8 })
+                memset(h, 0, alloc_size);
+            memset(b4, 0, N * sizeof(buffers4streams<T>));
         }
-        // 5
-        else if (MODE.substr(0, 6) == "5loads") {
-            h_expected_res[j] = 5 * h_input[j] + 1 + 2 + 3 + 4 + 5;
-            tmp = h_res[j];
+
+        cout << "\nBuffer implementation\n";
+        for (size_t t = 0; t < NB_ITER; ++t) {
+            auto const t1_buffer = high_resolution_clock::now();
+            sycl::event const buffer_event = buffer_iteration(MODE, streams, b4, N, queue);
+            auto const t2_buffer = high_resolution_clock::now();
+            std::chrono::duration<double, std::micro> const buffer_total = t2_buffer - t1_buffer;
+            double const buffer_compute = event_t_ns(buffer_event) / 1e3;
+
+            // The submission is not observable apart from the buffers' lifetime
+            trace_host(trace, "buffer", "buffer iteration", t1_buffer, t2_buffer, t);
+            trace_submit(trace, "buffer kernel", buffer_event, t2_buffer, t);
+
+            printf("  buffer time: %.2f ms (%.0f us kernel)\n", buffer_total.count() / 1e3, buffer_compute);
+            timers_buffer_total[t] = buffer_total.count();
+            timers_buffer_compute[t] = buffer_compute;
         }
-        else if (MODE.substr(0, 7) == "5stores") {
-            h_expected_res[j] = 5 * h_input[j] + 1 + 2 + 3 + 4 + 5;
-            tmp = h1[j] + h2[j] + h3[j] + h4[j] + h5[j];
+
+        if (MODE.substr(0, 14) == "4stores_struct") {
+            for (size_t i = 0; i < N; ++i) {
+                h1[i] = b4[i].d1;
+                h2[i] = b4[i].d2;
+                h3[i] = b4[i].d3;
+                h4[i] = b4[i].d4;
+            }
         }
+        verify_failed |= !host_verify_print(MODE, streams, N, h_expected_res, indices);
 
-        cout << "[" << j << "] res: " << tmp << " == " << h_expected_res[j];
-        if (std::abs(tmp - h_expected_res[j]) < tolerance) cout << " OK\n";
-        else cout << " FAIL\n";
+        auto const bytes = mode_bytes(MODE, N);
+        usm_buffer_print(timers_usm_total, timers_fpga_compute, timers_buffer_total, timers_buffer_compute,
+                         bytes.cpu_to_fpga + bytes.fpga_to_cpu);
     }
 
-    auto t2_simu = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> t_simu = t2_simu - t1_simu;
+    // Appended once the buffer runs are verified too
+    if (!results_path.empty()) {
+        auto const bytes = mode_bytes(MODE, N);
+        auto const timer = [](std::string const &name, std::array<double, NB_ITER> const &timers,
+                              size_t const timer_bytes) {
+            results_t const res = timers_stats(timers);
+            return results_timer_t{ name, res.mean, res.standard_deviation, res.min, res.max, NB_ITER,
+                                    timer_bytes };
+        };
+        results_record_t record;
+        record.mode = MODE;
+        record.type = std::is_same_v<T, double> ? "double" : "float";
+        record.device = device.get_info<info::device::name>();
+        record.driver = device.get_info<info::device::driver_version>();
+        record.compiler = __VERSION__;
+        record.revision = GIT_REVISION;
+        record.options = KERNEL_OPTION;
+        record.N = N;
+        record.unroll = mode_unroll(MODE);
+        record.alignment = alignment;
+        record.back_to_back = back_to_back;
+        record.kernel_only = kernel_only;
+        record.verification = verify_failed ? "failed" : "passed";
+        record.read_bandwidth = compute_mean > 0.0 ? double(loads * alloc_size) / compute_mean / 1e3 : 0.0;
+        record.write_bandwidth = compute_mean > 0.0 ? double(stores * alloc_size) / compute_mean / 1e3 : 0.0;
+        if (!kernel_only)
+            record.timers.push_back(timer("cpu_to_fpga", timers_cpu_to_fpga, bytes.cpu_to_fpga));
+        record.timers.push_back(timer("fpga_compute", timers_fpga_compute, bytes.fpga_compute));
+        if (!kernel_only)
+            record.timers.push_back(timer("fpga_to_cpu", timers_fpga_to_cpu, bytes.fpga_to_cpu));
+        if (!results_append(results_path, record))
+            cerr << "Could not append results to " << results_path << "\n";
+    }
 
-    timers_print(timers_cpu_to_fpga, "-- copy CPU to FPGA --");
-    timers_print(timers_fpga_compute, "-- FPGA compute time --");
-    timers_print(timers_fpga_to_cpu, "-- copy FPGA to CPU --");
 
-    printf("Simulation execution time: %.3lf s\n", t_simu.count() / 1e3);
-    printf("Iteration execution time:  %.3lf ms\n", t_simu.count() / double(NB_ITER - 1));
+    if (max_threads > 0) threads_sweep_print(MODE, streams, N, max_threads, shared_queue, kernel_only, queue);
+
+    if (!offsets.empty()) offsets_sweep_print(MODE, streams, N, offsets, kernel_only, queue);
+
+    if (tiled) reuse_sweep_print(MODE, streams, N, reuse, queue);
+
+    if (trace.enabled) {
+        if (trace_write(trace, trace_path)) cerr << "Trace written to " << trace_path << "\n";
+        else cerr << "Could not write trace to " << trace_path << "\n";
+    }
 
-    return 0;
+    return verify_failed ? 1 : 0;
 }
@@ -0,0 +1,320 @@
+#!/usr/bin/env python3
+"""Joins the FPGA optimization reports of the stream kernels with their measured bandwidths.
+
+Reads the JSON of saved report directories (kernel_<mode>_report.prj, from make report or a hardware
+compile) and the text output of runs (./kernel_<mode>.fpga N > kernel_<mode>.log), and prints per mode
+the loops (II, speculated iterations, max concurrency), the LSUs of every stream (type, style, width,
+stall-free), the fmax and the resources, then a summary table joining them with the run bandwidths.
+Everything is read from files, so saved directories can be analyzed without the board.
+
+Usage: ./report.py [--loops] [--lsus] REPORT_DIR... LOG...
+
+The report JSON layout changes across oneAPI versions, fields are matched by name rather than by
+position: tables with "columns" and "children" rows, instruction nodes with "details", and key/value
+objects such as the Quartus summaries. Older reports keeping their JSON in reports/lib/*.js files as
+"var name = {...};" are read too.
+"""
+
+import json
+import os
+import re
+import sys
+
+
+def mode_of(path):
+    """Mode of a report directory or a log file name, e.g. 8loads for kernel_8loads_report.prj."""
+    name = os.path.basename(os.path.normpath(path))
+    match = re.match(r"kernel_(.+?)(_report)?(\.a)?(\.prj|\.log|\.txt)?$", name)
+    return match.group(1) if match else name
+
+
+def number(value):
+    """First number in a report value, e.g. 512 for "512 bits", None if there is none."""
+    if isinstance(value, (int, float)):
+        return float(value)
+    match = re.search(r"-?\d+(\.\d+)?", str(value))
+    return float(match.group(0)) if match else None
+
+
+def load_json_files(directory):
+    """Every JSON document of a report directory, as (file name, document) pairs."""
+    documents = []
+    for root, _, files in os.walk(directory):
+        for file in sorted(files):
+            path = os.path.join(root, file)
+            try:
+                with open(path, encoding="utf-8", errors="replace") as f:
+                    text = f.read()
+            except OSError:
+                continue
+            if file.endswith(".json"):
+                chunks = [text]
+            elif file.endswith(".js"):
+                # var loopsJSON = {...};
+                chunks = re.findall(r"^\s*var\s+\w+\s*=\s*(.*?);?\s*$", text, re.M)
+            else:
+                continue
+            for chunk in chunks:
+                try:
+                    documents.append((file, json.loads(chunk)))
+                except ValueError:
+                    pass
+    return documents
+
+
+def walk(node):
+    """Every dictionary nested in a JSON document."""
+    if isinstance(node, dict):
+        yield node
+        for value in node.values():
+            yield from walk(value)
+    elif isinstance(node, list):
+        for value in node:
+            yield from walk(value)
+
+
+def location(node):
+    """file:line of a report node, from its debug information."""
+    for debug in walk(node.get("debug", [])):
+        if "line" in debug:
+            return "%s:%s" % (os.path.basename(str(debug.get("filename", ""))), debug["line"])
+    return ""
+
+
+def table_rows(table):
+    """Rows of a report table as dictionaries keyed by column name, nested rows included."""
+    columns = [str(c).strip() for c in table.get("columns", [])]
+    rows = []
+
+    def visit(children, parent):
+        for child in children if isinstance(children, list) else []:
+            if not isinstance(child, dict):
+                continue
+            data = child.get("data", [])
+            # The first column usually holds the row name, not a data entry
+            names = columns[1:] if len(data) == len(columns) - 1 else columns
+            row = dict(zip(names, data))
+            row["name"] = str(child.get("name", "")).strip()
+            row["parent"] = parent
+            row["location"] = location(child)
+            rows.append(row)
+            visit(child.get("children", []), row["name"])
+
+    visit(table.get("children", []), "")
+    return rows
+
+
+def column(row, *patterns):
+    """Value of the first column of a row matching one of the patterns, case-insensitive."""
+    for pattern in patterns:
+        for key, value in row.items():
+            if key not in ("name", "parent", "location") and re.search(pattern, key, re.I):
+                return value
+    return None
+
+
+def details(node):
+    """Key/value details of an instruction node, flattened."""
+    flat = {}
+    for entry in walk(node.get("details", [])):
+        for key, value in entry.items():
+            if isinstance(value, (str, int, float)) and key != "type":
+                flat[key] = value
+    return flat
+
+
+def detail(info, pattern, default=""):
+    """Value of the first detail whose key matches a pattern, case-insensitive."""
+    return next((v for k, v in info.items() if re.search(pattern, k, re.I)), default)
+
+
+def parse_report(directory):
+    """Loops, LSUs, stall points, fmax and resources of a report directory."""
+    report = {"loops": [], "lsus": [], "stalls": [], "fmax": None, "fmax_source": "", "resources": {}}
+    seen_lsus = set()
+    fmax_candidates = []
+
+    for file, document in load_json_files(directory):
+        for node in walk(document):
+            # Tables: loops and estimated resources
+            if isinstance(node.get("columns"), list) and isinstance(node.get("children"), list):
+                columns = " ".join(str(c) for c in node["columns"])
+                rows = table_rows(node)
+                if re.search(r"\bII\b", columns):
+                    for row in rows:
+                        ii = column(row, r"^II$")
+                        if ii in (None, "", "n/a"):
+                            continue
+                        report["loops"].append({
+                            "name": row["name"],
+                            "location": row["location"],
+                            "pipelined": column(row, r"pipelined") or "",
+                            "ii": ii,
+                            "speculated": column(row, r"speculated") or "",
+                            "concurrency": column(row, r"concurrency", r"interleav") or "",
+                            "fmax": column(row, r"fmax") or "",
+                        })
+                elif re.search(r"ALUT", columns, re.I) and re.search(r"RAM", columns, re.I):
+                    # The total row when there is one, else the sum of the kernel rows
+                    total = [r for r in rows if re.search(r"total", r["name"], re.I)]
+                    estimate = {}
+                    for row in total[:1] or [r for r in rows if not r["parent"]]:
+                        for key in ("ALUT", "FF", "RAM", "DSP", "MLAB"):
+                            value = number(column(row, r"^" + key) or "")
+                            if value is not None:
+                                estimate[key] = estimate.get(key, 0.0) + value
+                    if report["resources"].get("source") != "quartus":
+                        report["resources"] = dict(estimate, source="estimate")
+                for row in rows:
+                    value = column(row, r"fmax")
+                    if value is not None and number(value) is not None:
+                        fmax_candidates.append((file, "table", number(value)))
+
+            # Quartus summaries: {"name": "...", "alut": ..., "reg": ..., "ram": ..., "dsp": ...}
+            lowered = {str(k).lower(): v for k, v in node.items()}
+            summary = re.search(r"kernel system|total", str(node.get("name", "")), re.I)
+            if "alut" in lowered and "ram" in lowered and summary:
+                report["resources"] = {}
+                for key, name in (("alut", "ALUT"), ("reg", "FF"), ("ram", "RAM"), ("dsp", "DSP"),
+                                  ("mlab", "MLAB")):
+                    if number(lowered.get(key, "")) is not None:
+                        report["resources"][name] = number(lowered[key])
+                report["resources"]["source"] = "quartus"
+            # Quartus reports the post-fit clock as "kernel clock", the compiler its estimates as fmax.
+            # The 2x clock runs at twice the kernel clock
+            for key, value in lowered.items():
+                if re.search(r"fmax|clock", key) and "2x" not in key and number(value) is not None:
+                    fmax_candidates.append((file, key, number(value)))
+
+            # Instruction nodes: LSUs and stall points
+            name = str(node.get("name", ""))
+            if "details" in node and node.get("type") == "inst":
+                info = details(node)
+                where = location(node)
+                kind = ""
+                if re.match(r"(LD|Load|Read)", name):
+                    kind = "load"
+                elif re.match(r"(ST|Store|Write)", name):
+                    kind = "store"
+                if kind and (where, kind, name) not in seen_lsus:
+                    seen_lsus.add((where, kind, name))
+                    report["lsus"].append({
+                        "kind": kind,
+                        "location": where,
+                        "style": detail(info, r"style|lsu type"),
+                        "width": number(detail(info, r"width")),
+                        "stall_free": detail(info, r"stall.free"),
+                    })
+                stall_free = detail(info, r"stall.free", None)
+                if str(stall_free).lower() == "no":
+                    report["stalls"].append("%s %s" % (name, where))
+
+    # Post-fit (Quartus) kernel clock first, then any value of a Quartus file, then the compiler estimates
+    quartus = ([c for c in fmax_candidates if "kernel clock" in c[1]] or
+               [c for c in fmax_candidates if "quartus" in os.path.basename(c[0]).lower()])
+    if quartus:
+        file, key, value = quartus[0]
+        report["fmax"], report["fmax_source"] = value, "quartus, %s in %s" % (key, os.path.basename(file))
+    elif fmax_candidates:
+        # The slowest block sets the kernel clock
+        file, key, value = min(fmax_candidates, key=lambda c: c[2])
+        report["fmax"], report["fmax_source"] = value, "estimate, %s in %s" % (key, os.path.basename(file))
+    return report
+
+
+def parse_log(path):
+    """Mode, count of elements, compute time and kernel bandwidths of a run output."""
+    run = {"mode": mode_of(path), "items": None, "compute_us": None, "read": None, "written": None}
+    section = ""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            if line.startswith("Mode:"):
+                run["mode"] = line.split(":", 1)[1].strip()
+            elif line.startswith("Items:"):
+                run["items"] = int(line.split(":", 1)[1])
+            elif line.startswith("--"):
+                section = line.strip()
+            elif line.startswith("Average execution time") and "FPGA compute" in section:
+                run["compute_us"] = number(line.split(")", 1)[1])
+            elif line.startswith("Kernel bandwidth:"):
+                values = re.findall(r"([\d.]+) GB/s", line)
+                run["read"], run["written"] = float(values[0]), float(values[1])
+    return run
+
+
+def fmt(value, spec="%.1f"):
+    return "-" if value is None or value == "" else spec % value if isinstance(value, float) else str(value)
+
+
+def print_report(mode, report, show_loops, show_lsus):
+    print("-----------------------------------------------------------")
+    print("-- %s --" % mode)
+    print("fmax: %s MHz (%s)" % (fmt(report["fmax"]), report["fmax_source"] or "not found"))
+    resources = report["resources"]
+    keys = ("ALUT", "FF", "RAM", "DSP", "MLAB")
+    usage = ", ".join("%s %s" % (key, fmt(resources.get(key), "%.0f")) for key in keys)
+    print("Resources (%s): %s" % (resources.get("source", "not found"), usage))
+    if show_loops:
+        print("%-40s %-24s %-10s %6s %12s %12s" % (
+            "loop", "location", "pipelined", "II", "speculated", "concurrency"))
+        for loop in report["loops"]:
+            print("%-40s %-24s %-10s %6s %12s %12s" % (loop["name"][:40], loop["location"], loop["pipelined"],
+                                                     loop["ii"], loop["speculated"], loop["concurrency"]))
+    if show_lsus:
+        print("%-6s %-24s %-28s %10s %10s" % ("LSU", "location", "style", "width (b)", "stall-free"))
+        for lsu in sorted(report["lsus"], key=lambda l: (l["kind"], l["location"])):
+            print("%-6s %-24s %-28s %10s %10s" % (lsu["kind"], lsu["location"], str(lsu["style"])[:28],
+                                                fmt(lsu["width"], "%.0f"), lsu["stall_free"]))
+    if report["stalls"]:
+        print("Stall points: " + ", ".join(report["stalls"]))
+    print()
+
+
+def main(argv):
+    show_loops = "--loops" in argv or "--lsus" not in argv
+    show_lsus = "--lsus" in argv or "--loops" not in argv
+    paths = [a for a in argv if not a.startswith("--")]
+    if not paths:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+
+    reports, runs = {}, {}
+    for path in paths:
+        if os.path.isdir(path):
+            reports[mode_of(path)] = parse_report(path)
+        elif os.path.isfile(path):
+            run = parse_log(path)
+            runs.setdefault(run["mode"], []).append(run)
+        else:
+            print("No such report directory or log: %s" % path, file=sys.stderr)
+
+    for mode in sorted(reports):
+        print_report(mode, reports[mode], show_loops, show_lsus)
+
+    # One row per mode, the peak is what the LSU widths allow at fmax and at the worst II
+    print("%-24s %8s %6s %6s %8s %8s %6s %6s %11s %11s %11s %11s" % (
+        "mode", "fmax", "II", "LSUs", "stalls", "ALUT", "RAM", "DSP", "peak GB/s", "read GB/s", "write GB/s",
+        "efficiency"))
+    for mode in sorted(set(reports) | set(runs)):
+        report = reports.get(mode, {"loops": [], "lsus": [], "stalls": [], "fmax": None, "resources": {}})
+        measured = [r for r in runs.get(mode, []) if r["read"] is not None]
+        read = sum(r["read"] for r in measured) / len(measured) if measured else None
+        written = sum(r["written"] for r in measured) / len(measured) if measured else None
+        iis = [number(loop["ii"]) for loop in report["loops"] if number(loop["ii"]) is not None]
+        ii = max(iis) if iis else None
+        widths = [lsu["width"] for lsu in report["lsus"] if lsu["width"]]
+        peak = None
+        if report["fmax"] and widths:
+            peak = report["fmax"] * 1e6 * sum(widths) / 8 / (ii or 1) / 1e9
+        efficiency = (read + written) / peak * 100 if peak and read is not None else None
+        resources = report["resources"]
+        print("%-24s %8s %6s %6d %8d %8s %6s %6s %11s %11s %11s %11s" % (
+            mode, fmt(report["fmax"]), fmt(ii, "%.0f"), len(report["lsus"]), len(report["stalls"]),
+            fmt(resources.get("ALUT"), "%.0f"), fmt(resources.get("RAM"), "%.0f"),
+            fmt(resources.get("DSP"), "%.0f"),
+            fmt(peak, "%.2f"), fmt(read, "%.2f"), fmt(written, "%.2f"), fmt(efficiency, "%.1f%%")))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
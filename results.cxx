@@ -0,0 +1,65 @@
+#include "results.hpp"
+
+#include <cstdio>
+#include <ctime>
+
+/*** Writes a JSON string, escaping quotes, backslashes and control characters.
+ * @param f output file
+ * @param s the string
+ */
+static void write_string(FILE *f, std::string const &s)
+{
+    fputc('"', f);
+    for (char const c : s) {
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (static_cast<unsigned char>(c) < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/*** Appends a run to a results store, one JSON object per line, along with the
+ * current UTC date.
+ * @param path the results store
+ * @param record the run
+ */
+bool results_append(std::string const &path, results_record_t const &record)
+{
+    FILE *f = fopen(path.c_str(), "a");
+    if (f == nullptr) return false;
+
+    char date[32];
+    time_t const now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(f, "{\"date\":\"%s\",\"mode\":", date);
+    write_string(f, record.mode);
+    fprintf(f, ",\"N\":%zu,\"type\":", record.N);
+    write_string(f, record.type);
+    fprintf(f, ",\"unroll\":%zu,\"device\":", record.unroll);
+    write_string(f, record.device);
+    fprintf(f, ",\"driver\":");
+    write_string(f, record.driver);
+    fprintf(f, ",\"compiler\":");
+    write_string(f, record.compiler);
+    fprintf(f, ",\"revision\":");
+    write_string(f, record.revision);
+    fprintf(f, ",\"options\":");
+    write_string(f, record.options);
+    fprintf(f, ",\"alignment\":%zu,\"back_to_back\":%s,\"kernel_only\":%s", record.alignment,
+            record.back_to_back ? "true" : "false", record.kernel_only ? "true" : "false");
+    fprintf(f, ",\"verification\":");
+    write_string(f, record.verification);
+    fprintf(f, ",\"read_bandwidth\":%.6g,\"write_bandwidth\":%.6g,\"timers\":{", record.read_bandwidth,
+            record.write_bandwidth);
+    for (size_t k = 0; k < record.timers.size(); ++k) {
+        results_timer_t const &t = record.timers[k];
+        fprintf(f, "%s", k > 0 ? "," : "");
+        write_string(f, t.name);
+        fprintf(f, ":{\"mean\":%.6g,\"sd\":%.6g,\"min\":%.6g,\"max\":%.6g,\"n\":%zu,\"bytes\":%zu}", t.mean,
+                t.standard_deviation, t.min, t.max, t.count, t.bytes);
+    }
+    fprintf(f, "}}\n");
+
+    return fclose(f) == 0;
+}
@@ -0,0 +1,30 @@
+#ifndef RESULTS_H_
+#define RESULTS_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*** Statistics of one timer of a run, in us, and the bytes it moves per
+ * iteration.
+ */
+struct results_timer_t {
+    std::string name;
+    double mean, standard_deviation, min, max;
+    size_t count, bytes;
+};
+
+/*** One run, as appended to the results store. verification is "passed" or
+ * "failed", from the host and device verifications that ran.
+ */
+struct results_record_t {
+    std::string mode, type, device, driver, compiler, revision, options, verification;
+    std::vector<results_timer_t> timers;
+    double read_bandwidth, write_bandwidth;
+    size_t N, unroll, alignment;
+    bool back_to_back, kernel_only;
+};
+
+bool results_append(std::string const &path, results_record_t const &record);
+
+#endif // RESULTS_H_
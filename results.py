@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Lists the runs of a results store and detects bandwidth regressions between runs.
+
+Every run of a kernel_* executable appends one JSON line to results.jsonl (see --results): mode, N,
+type, unroll, device, driver, compiler, git revision, kernel options, alignment, whether its host and
+device verifications passed, and the mean, standard deviation and count of its copy and kernel timers.
+
+Usage:
+  ./results.py list [--store FILE] [--mode MODE]
+  ./results.py compare [--store FILE] [--mode MODE] [--baseline REV] [--threshold PCT] [--alpha P]
+
+compare takes, for each configuration (mode, N, type, unroll, device, options, alignment, back-to-back,
+kernel-only), its latest run and a baseline run: the previous one, or the latest one at git revision REV.
+Runs that failed verification are left out. Each timer
+is compared with a two-sided Welch t-test. A timer regresses when its bandwidth drops by more than the
+threshold (default 5%) with p below alpha (default 0.01). Compiler, driver and device changes between
+the two runs are printed. The exit status is 1 when any timer regresses, so a toolchain or BSP upgrade
+can be checked by running the kernels again right after it:
+  ./kernel_8loads.fpga 10000000 && ./results.py compare --mode 8loads
+"""
+
+import json
+import math
+import sys
+
+CONFIGURATION = ("mode", "N", "type", "unroll", "device", "options", "alignment", "back_to_back",
+                 "kernel_only")
+
+
+def load(path):
+    """Runs of a results store, oldest first, skipping unreadable lines."""
+    runs = []
+    try:
+        with open(path, encoding="utf-8") as f:
+            for number, line in enumerate(f, 1):
+                try:
+                    runs.append(json.loads(line))
+                except ValueError:
+                    print("%s:%d: skipping unreadable line" % (path, number), file=sys.stderr)
+    except OSError as error:
+        print("Could not read %s: %s" % (path, error), file=sys.stderr)
+    return runs
+
+
+def configuration(run):
+    return tuple(run.get(key) for key in CONFIGURATION)
+
+
+def incomplete_beta(x, a, b):
+    """Regularized incomplete beta function I_x(a, b), by its continued fraction."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    if x > (a + 1.0) / (a + b + 2.0):
+        return 1.0 - incomplete_beta(1.0 - x, b, a)
+    log_front = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1.0 - x)
+    front = math.exp(log_front) / a
+    # Lentz's algorithm
+    tiny = 1e-300
+    c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    f = d
+    for m in range(1, 300):
+        for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                          -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            f *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return front * f
+
+
+def welch(mean1, sd1, n1, mean2, sd2, n2):
+    """Two-sided p-value of Welch's t-test between two samples given by their statistics."""
+    v1, v2 = sd1 * sd1 / n1, sd2 * sd2 / n2
+    if v1 + v2 == 0.0:
+        return 0.0 if mean1 != mean2 else 1.0
+    t = (mean1 - mean2) / math.sqrt(v1 + v2)
+    df = (v1 + v2) ** 2 / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1))
+    return incomplete_beta(df / (df + t * t), df / 2.0, 0.5)
+
+
+def bandwidth(timer):
+    """Bandwidth of a timer in GB/s, from its bytes per iteration and mean time in us."""
+    return timer["bytes"] / timer["mean"] / 1e3 if timer["mean"] > 0 else 0.0
+
+
+def option(argv, name, default):
+    if name in argv:
+        index = argv.index(name)
+        if index + 1 < len(argv):
+            return argv[index + 1]
+    return default
+
+
+def list_runs(runs):
+    print("%-20s %-20s %10s %-7s %6s %-12s %-24s %10s %10s  %s" % (
+        "date", "mode", "N", "type", "unroll", "revision", "device", "read GB/s", "write GB/s",
+        "verification"))
+    for run in runs:
+        print("%-20s %-20s %10d %-7s %6d %-12s %-24s %10.2f %10.2f  %s" % (
+            run.get("date", ""), run.get("mode", ""), run.get("N", 0), run.get("type", ""),
+            run.get("unroll", 1), run.get("revision", "")[:12], run.get("device", "")[:24],
+            run.get("read_bandwidth", 0.0), run.get("write_bandwidth", 0.0), run.get("verification", "")))
+    return 0
+
+
+def compare(runs, baseline_revision, threshold, alpha):
+    # The timings of a run that computed wrong results are not comparable
+    runs = [run for run in runs if run.get("verification") != "failed"]
+    latest = {}
+    for index, run in enumerate(runs):
+        latest[configuration(run)] = index
+
+    regressions = 0
+    print("%-20s %10s %-13s %-12s %-12s %12s %12s %9s %10s  %s" % (
+        "mode", "N", "timer", "baseline", "new", "base GB/s", "new GB/s", "change", "p-value", "verdict"))
+    for key, index in sorted(latest.items(), key=lambda item: item[1]):
+        new = runs[index]
+        earlier = [run for run in runs[:index] if configuration(run) == key]
+        if baseline_revision:
+            candidates = [run for run in earlier if run.get("revision", "").startswith(baseline_revision)]
+        else:
+            candidates = earlier
+        if not candidates:
+            continue
+        base = candidates[-1]
+
+        for field in ("compiler", "driver", "device"):
+            if base.get(field) != new.get(field):
+                print("%-20s %10d %s changed: %s -> %s" % (new["mode"], new["N"], field, base.get(field),
+                                                          new.get(field)))
+
+        for name, timer in new.get("timers", {}).items():
+            reference = base.get("timers", {}).get(name)
+            if reference is None or timer["n"] < 2 or reference["n"] < 2:
+                continue
+            base_bandwidth, new_bandwidth = bandwidth(reference), bandwidth(timer)
+            change = (new_bandwidth / base_bandwidth - 1.0) * 100 if base_bandwidth > 0 else 0.0
+            p = welch(reference["mean"], reference["sd"], reference["n"], timer["mean"], timer["sd"],
+                      timer["n"])
+            verdict = "ok"
+            if p < alpha and change < -threshold:
+                verdict = "REGRESSION"
+                regressions += 1
+            elif p < alpha and change > threshold:
+                verdict = "improvement"
+            elif p < alpha:
+                verdict = "significant, within threshold"
+            print("%-20s %10d %-13s %-12s %-12s %12.2f %12.2f %8.1f%% %10.2g  %s" % (
+                new["mode"], new["N"], name, base.get("revision", "")[:12], new.get("revision", "")[:12],
+                base_bandwidth, new_bandwidth, change, p, verdict))
+
+    if regressions:
+        print("\n%d timer(s) regressed by more than %g%% (p < %g)" % (regressions, threshold, alpha))
+    return 1 if regressions else 0
+
+
+def main(argv):
+    if not argv or argv[0] not in ("list", "compare"):
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    runs = load(option(argv, "--store", "results.jsonl"))
+    mode = option(argv, "--mode", None)
+    if mode:
+        runs = [run for run in runs if run.get("mode") == mode]
+    if argv[0] == "list":
+        return list_runs(runs)
+    return compare(runs, option(argv, "--baseline", None), float(option(argv, "--threshold", 5.0)),
+                   float(option(argv, "--alpha", 0.01)))
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
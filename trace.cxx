@@ -0,0 +1,154 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+/*** Returns the index of a named track, adding it if needed.
+ * @param tracks the tracks names
+ * @param name the track name
+ */
+static size_t track_index(std::vector<std::string> &tracks, std::string_view const name)
+{
+    auto const it = std::find(tracks.begin(), tracks.end(), name);
+    if (it != tracks.end()) return size_t(it - tracks.begin());
+    tracks.emplace_back(name);
+    return tracks.size() - 1;
+}
+
+static double since_origin_us(trace_t const &trace, trace_clock::time_point const t)
+{
+    return std::chrono::duration<double, std::micro>(t - trace.origin).count();
+}
+
+/*** Records a host span, e.g. a submission or a wait.
+ * @param trace the trace
+ * @param track host track, e.g. "submit" or "wait"
+ * @param name span's name
+ * @param t1 start time
+ * @param t2 end time
+ * @param iteration iteration index
+ */
+void trace_host(trace_t &trace, std::string_view const track, std::string_view const name,
+                trace_clock::time_point const t1, trace_clock::time_point const t2, size_t const iteration)
+{
+    if (!trace.enabled) return;
+    trace.host_spans.push_back({ std::string(name), track_index(trace.host_tracks, track), iteration,
+                                 since_origin_us(trace, t1),
+                                 std::chrono::duration<double, std::micro>(t2 - t1).count() });
+}
+
+/*** Records the submission of a device command, from t1 until now, and the
+ * command itself. Its profiling info is only read by trace_write, once the
+ * command completed.
+ * @param trace the trace
+ * @param name command's name, also used as its device track
+ * @param event the command's event
+ * @param t1 host time the submission started
+ * @param iteration iteration index
+ */
+void trace_submit(trace_t &trace, std::string_view const name, sycl::event const &event,
+                  trace_clock::time_point const t1, size_t const iteration)
+{
+    if (!trace.enabled) return;
+    auto const submitted = trace_clock::now();
+    trace_host(trace, "submit", name, t1, submitted, iteration);
+    trace.device_commands.push_back(
+        { std::string(name), track_index(trace.device_tracks, name), iteration, event, submitted });
+}
+
+/*** Records the submission of a set of device commands, each on its own device
+ * track so that concurrent commands do not overlap on the timeline.
+ * @param trace the trace
+ * @param name commands' name, suffixed with their index for their tracks
+ * @param events the commands' events
+ * @param t1 host time the submissions started
+ * @param iteration iteration index
+ */
+void trace_submit(trace_t &trace, std::string_view const name, std::vector<sycl::event> const &events,
+                  trace_clock::time_point const t1, size_t const iteration)
+{
+    if (!trace.enabled) return;
+    auto const submitted = trace_clock::now();
+    trace_host(trace, "submit", name, t1, submitted, iteration);
+    for (size_t k = 0; k < events.size(); ++k) {
+        std::string const track = std::string(name) + " #" + std::to_string(k);
+        trace.device_commands.push_back(
+            { std::string(name), track_index(trace.device_tracks, track), iteration, events[k], submitted });
+    }
+}
+
+/*** Records a host wait, from t1 until now.
+ * @param trace the trace
+ * @param name what is waited for
+ * @param t1 host time the wait started
+ * @param iteration iteration index
+ */
+void trace_wait(trace_t &trace, std::string_view const name, trace_clock::time_point const t1,
+                size_t const iteration)
+{
+    trace_host(trace, "wait", name, t1, trace_clock::now(), iteration);
+}
+
+static void write_metadata(FILE *f, size_t const pid, size_t const tid, char const *what,
+                           std::string const &name)
+{
+    fprintf(f, "{\"ph\":\"M\",\"pid\":%zu,\"tid\":%zu,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}", pid, tid,
+            what, name.c_str());
+}
+
+static void write_span(FILE *f, size_t const pid, trace_span_t const &s)
+{
+    fprintf(f,
+            "{\"ph\":\"X\",\"pid\":%zu,\"tid\":%zu,\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f,"
+            "\"args\":{\"iteration\":%zu}}",
+            pid, s.track, s.name.c_str(), s.ts_us, s.dur_us, s.iteration);
+}
+
+/*** Writes the trace as Chrome trace-event JSON. Device timestamps are moved to
+ * the host clock with a single offset, the smallest gap between a command's
+ * device submit time and the host time its submission returned.
+ * @param trace the trace
+ * @param path output file
+ */
+bool trace_write(trace_t const &trace, std::string const &path)
+{
+    FILE *f = fopen(path.c_str(), "w");
+    if (f == nullptr) return false;
+
+    double offset_us = std::numeric_limits<double>::max();
+    for (auto const &c : trace.device_commands) {
+        auto const submit = c.event.get_profiling_info<sycl::info::event_profiling::command_submit>();
+        double const submit_us = static_cast<double>(submit) / 1e3;
+        offset_us = std::min(offset_us, since_origin_us(trace, c.submitted) - submit_us);
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    write_metadata(f, 1, 0, "process_name", "host");
+    fprintf(f, ",\n");
+    write_metadata(f, 2, 0, "process_name", "device");
+    for (size_t k = 0; k < trace.host_tracks.size(); ++k) {
+        fprintf(f, ",\n");
+        write_metadata(f, 1, k, "thread_name", trace.host_tracks[k]);
+    }
+    for (size_t k = 0; k < trace.device_tracks.size(); ++k) {
+        fprintf(f, ",\n");
+        write_metadata(f, 2, k, "thread_name", trace.device_tracks[k]);
+    }
+
+    for (auto const &s : trace.host_spans) {
+        fprintf(f, ",\n");
+        write_span(f, 1, s);
+    }
+    for (auto const &c : trace.device_commands) {
+        auto const start = c.event.get_profiling_info<sycl::info::event_profiling::command_start>();
+        auto const end = c.event.get_profiling_info<sycl::info::event_profiling::command_end>();
+        trace_span_t const s{ c.name, c.track, c.iteration, static_cast<double>(start) / 1e3 + offset_us,
+                              static_cast<double>(end - start) / 1e3 };
+        fprintf(f, ",\n");
+        write_span(f, 2, s);
+    }
+    fprintf(f, "\n]}\n");
+
+    return fclose(f) == 0;
+}
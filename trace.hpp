@@ -0,0 +1,48 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <chrono>
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <sycl/sycl.hpp>
+#include <vector>
+
+using trace_clock = std::chrono::high_resolution_clock;
+
+/*** A span already resolved to host time. */
+struct trace_span_t {
+    std::string name;
+    size_t track, iteration;
+    double ts_us, dur_us;
+};
+
+/*** A device command, resolved to host time once every command completed. */
+struct trace_device_t {
+    std::string name;
+    size_t track, iteration;
+    sycl::event event;
+    trace_clock::time_point submitted;
+};
+
+/*** Timeline of every submission, wait and device command of a run, written as
+ * a Chrome trace-event JSON file (chrome://tracing, ui.perfetto.dev).
+ */
+struct trace_t {
+    trace_clock::time_point origin = trace_clock::now();
+    std::vector<std::string> host_tracks, device_tracks;
+    std::vector<trace_span_t> host_spans;
+    std::vector<trace_device_t> device_commands;
+    bool enabled = false;
+};
+
+void trace_host(trace_t &trace, std::string_view track, std::string_view name, trace_clock::time_point t1,
+                trace_clock::time_point t2, size_t iteration);
+void trace_submit(trace_t &trace, std::string_view name, sycl::event const &event, trace_clock::time_point t1,
+                  size_t iteration);
+void trace_submit(trace_t &trace, std::string_view name, std::vector<sycl::event> const &events,
+                  trace_clock::time_point t1, size_t iteration);
+void trace_wait(trace_t &trace, std::string_view name, trace_clock::time_point t1, size_t iteration);
+bool trace_write(trace_t const &trace, std::string const &path);
+
+#endif // TRACE_H_
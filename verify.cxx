@@ -0,0 +1,47 @@
+#include "define.hpp"
+#include "kernel.hpp"
+
+static constexpr size_t SUM_LATENCY = 8;
+
+// Stream k (0-based) of the nstreams output streams is expected to hold slope * i + offset + k
+sycl::event launcher_verify(T *d1, T *d2, T *d3, T *d4, T *d5, T *d6, T *d7, T *d8, size_t nstreams, T slope,
+                            T offset, T tolerance, verify_result_t *d_result, size_t N, sycl::queue queue)
+{
+    return queue.submit([&](sycl::handler &h) {
+        h.single_task([=]() [[intel::kernel_args_restrict]] {
+            // Start of kernel
+            T *const d[8] = { d1, d2, d3, d4, d5, d6, d7, d8 };
+            // Shift register of partial checksums, so that the adder latency does not limit the loop II
+            [[intel::fpga_register]] double partial[SUM_LATENCY + 1] = {};
+            size_t errors = 0;
+
+            for (size_t i = 0; i < N; ++i) {
+                T const expected = slope * T(i) + offset;
+                double sum = 0.0;
+                size_t row_errors = 0;
+#pragma unroll
+                for (size_t k = 0; k < 8; ++k) {
+                    if (k < nstreams) {
+                        T const x = d[k][i];
+                        T const diff = x - (expected + T(k));
+                        sum += double(x);
+                        if (diff >= tolerance || diff <= -tolerance) ++row_errors;
+                    }
+                }
+                errors += row_errors;
+                partial[SUM_LATENCY] = partial[0] + sum;
+#pragma unroll
+                for (size_t j = 0; j < SUM_LATENCY; ++j)
+                    partial[j] = partial[j + 1];
+            }
+
+            double checksum = 0.0;
+#pragma unroll
+            for (size_t j = 0; j < SUM_LATENCY; ++j)
+                checksum += partial[j];
+            d_result->checksum = checksum;
+            d_result->errors = errors;
+            // End of kernel
+        });
+    });
+}